@@ -0,0 +1,155 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "Batch.h"
+#include "Pipeline.h"
+#include "ResultCache.h"
+
+#include <eavlException.h>
+#include <eavlVTKExporter.h>
+
+#include <fstream>
+
+// ****************************************************************************
+// Function:  BatchUsage
+//
+// Purpose:
+///   Print the command line options for batch mode.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+BatchUsage(const char *prog)
+{
+    cerr << "Usage: " << prog << " -batch <pipeline.xml> [options]\n"
+         << "  -var <name>      also read this variable (may be repeated)\n"
+         << "  -allvars         read every variable of the mesh\n"
+         << "  -o <prefix>      write the result to <prefix>.<chunk>.vtk\n"
+         << "  -repeat <n>      execute the operations n times (for timing)\n";
+}
+
+// ****************************************************************************
+// Function:  WriteResults
+//
+// Purpose:
+///   Write one VTK file per chunk of the pipeline's output.  The exporter
+///   writes one cell set, so we use the last one, which is the one the
+///   final operation added (if it added any).
+//
+// Arguments:
+//   pipe       the executed pipeline
+//   prefix     the output file name prefix
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+WriteResults(Pipeline *pipe, const string &prefix)
+{
+    for (size_t c=0; c<pipe->output.size(); ++c)
+    {
+        eavlDataSet *ds = pipe->output[c];
+        if (!ds || ds->GetNumCellSets() == 0)
+            continue;
+
+        ostringstream fn;
+        fn << prefix << "." << c << ".vtk";
+        ofstream out(fn.str().c_str());
+        if (!out)
+            throw eavlException(string("couldn't write ") + fn.str());
+
+        eavlVTKExporter exporter(ds, ds->GetNumCellSets()-1);
+        exporter.Export(out);
+        cout << "Wrote " << fn.str() << endl;
+    }
+}
+
+// ****************************************************************************
+// Function:  RunBatch
+//
+// Purpose:
+///   Load, execute, and write a saved pipeline.  See Batch.h.
+//
+// Arguments:
+//   argc, argv the command line; argv[1] is "-batch"
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+int
+RunBatch(int argc, char *argv[])
+{
+    string pipefile, prefix;
+    vector<string> vars;
+    bool allvars = false;
+    int repeat = 1;
+    for (int i=2; i<argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-var" && i+1 < argc)
+            vars.push_back(argv[++i]);
+        else if (arg == "-allvars")
+            allvars = true;
+        else if (arg == "-o" && i+1 < argc)
+            prefix = argv[++i];
+        else if (arg == "-repeat" && i+1 < argc)
+            repeat = atoi(argv[++i]);
+        else if (pipefile == "" && arg[0] != '-')
+            pipefile = arg;
+        else
+        {
+            BatchUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (pipefile == "" || repeat < 1)
+    {
+        BatchUsage(argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        Pipeline *pipe = Pipeline::Load(pipefile);
+        Pipeline::allPipelines.push_back(pipe);
+
+        if (allvars)
+            vars = pipe->GetUnloadedVariables();
+        for (size_t i=0; i<vars.size(); ++i)
+            pipe->RequestVariable(vars[i]);
+
+        for (int r=0; r<repeat; ++r)
+        {
+            if (r > 0)
+            {
+                // Free the operation results so they're computed again.
+                // What we read from the file stays cached, so repeats
+                // time the operations alone.
+                pipe->output.clear();
+                pipe->ClearResults();
+                size_t budget = ResultCache::GetMemoryBudget();
+                ResultCache::SetMemoryBudget(0);
+                Pipeline::TrimCache();
+                ResultCache::SetMemoryBudget(budget);
+            }
+
+            pipe->Execute();
+            pipe->Publish();
+            pipe->PrintStats(cout);
+        }
+
+        if (prefix != "")
+            WriteResults(pipe, prefix);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        return 1;
+    }
+    return 0;
+}
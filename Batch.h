@@ -0,0 +1,21 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef BATCH_H
+#define BATCH_H
+
+// ****************************************************************************
+// Function:  RunBatch
+//
+// Purpose:
+///   Execute a saved pipeline without the GUI, e.g.
+///     eavlab -batch pipeline.xml [-var name]... [-o prefix] [-repeat n]
+///   writing each chunk of the result as a VTK file and the per-stage
+///   profiling stats to stdout.  Returns the process exit code.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+int RunBatch(int argc, char *argv[]);
+
+#endif
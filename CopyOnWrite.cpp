@@ -0,0 +1,391 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "CopyOnWrite.h"
+
+#include <eavlArray.h>
+#include <eavlCellSetExplicit.h>
+#include <eavlCoordinates.h>
+#include <eavlException.h>
+
+#include <algorithm>
+#include <set>
+
+// ****************************************************************************
+// Struct:  DataSetShell, FieldShell
+//
+// Purpose:
+///   EAVL data sets and fields have no way to let go of what they
+///   point to, and their destructors may free it.  Ours are mostly
+///   shallow copies sharing those parts with other stages, so these
+///   reach the member lists to empty them before deleting one.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct DataSetShell : public eavlDataSet
+{
+    static void Empty(eavlDataSet *ds)
+    {
+        (ds->*(&DataSetShell::fields)).clear();
+        (ds->*(&DataSetShell::cellsets)).clear();
+        (ds->*(&DataSetShell::coordinateSystems)).clear();
+        (ds->*(&DataSetShell::logicalStructure)) = NULL;
+    }
+};
+
+struct FieldShell : public eavlField
+{
+    static void Empty(eavlField *f)
+    {
+        (f->*(&FieldShell::field)) = NULL;
+    }
+};
+
+// ****************************************************************************
+// Function:  CreateCopyOnWriteInput
+//
+// Purpose:
+///   Create a new data set sharing everything with the given one except
+///   for the listed parts, which are deep copies.  With nothing listed,
+///   this is just a shallow copy.
+//
+// Arguments:
+//   ds         the data set to copy
+//   modified   the parts which the caller intends to change in place
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlDataSet *
+CreateCopyOnWriteInput(eavlDataSet *ds, const DataSetParts &modified)
+{
+    if (modified.fields.empty() &&
+        modified.coordinateSystems.empty() &&
+        modified.cellSets.empty())
+    {
+        return ds->CreateShallowCopy();
+    }
+
+    eavlDataSet *out = new eavlDataSet;
+    out->SetNumPoints(ds->GetNumPoints());
+    out->SetLogicalStructure(ds->GetLogicalStructure());
+
+    for (int i=0; i<ds->GetNumCoordinateSystems(); ++i)
+    {
+        eavlCoordinates *cs = ds->GetCoordinateSystem(i);
+        if (std::find(modified.coordinateSystems.begin(),
+                      modified.coordinateSystems.end(), i) !=
+            modified.coordinateSystems.end())
+        {
+            cs = CopyCoordinates(cs);
+        }
+        out->AddCoordinateSystem(cs);
+    }
+
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+    {
+        eavlCellSet *cs = ds->GetCellSet(i);
+        if (std::find(modified.cellSets.begin(),
+                      modified.cellSets.end(), cs->GetName()) !=
+            modified.cellSets.end())
+        {
+            cs = CopyCellSet(cs);
+        }
+        out->AddCellSet(cs);
+    }
+
+    for (int i=0; i<ds->GetNumFields(); ++i)
+    {
+        eavlField *f = ds->GetField(i);
+        if (std::find(modified.fields.begin(),
+                      modified.fields.end(), f->GetArray()->GetName()) !=
+            modified.fields.end())
+        {
+            f = CopyField(f);
+        }
+        out->AddField(f);
+    }
+
+    return out;
+}
+
+// ****************************************************************************
+// Function:  FreeCopyOnWriteInput
+//
+// Purpose:
+///   Free what CreateCopyOnWriteInput made for an operation which then
+///   returned a different data set: the structure, and whatever was
+///   copied for it (or added to it) that the output doesn't use.  Call
+///   with a NULL output if the operation failed.
+///
+///   A copied coordinate system shares its axes with the original (see
+///   CopyCoordinates), and deleting it may take them along, so those
+///   are left alone.  They're tiny.
+//
+// Arguments:
+//   ds         the data set the input was made from
+//   input      the copy-on-write input
+//   output     what the operation returned, or NULL
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+FreeCopyOnWriteInput(eavlDataSet *ds, eavlDataSet *input,
+                     eavlDataSet *output)
+{
+    if (input == output || input == ds)
+        return;
+
+    std::set<void*> keep;
+    eavlDataSet *kept[2] = {ds, output};
+    for (int k=0; k<2; ++k)
+    {
+        if (!kept[k])
+            continue;
+        for (int i=0; i<kept[k]->GetNumFields(); ++i)
+        {
+            keep.insert(kept[k]->GetField(i));
+            keep.insert(kept[k]->GetField(i)->GetArray());
+        }
+        for (int i=0; i<kept[k]->GetNumCellSets(); ++i)
+            keep.insert(kept[k]->GetCellSet(i));
+    }
+
+    for (int i=0; i<input->GetNumFields(); ++i)
+    {
+        eavlField *f = input->GetField(i);
+        if (!keep.count(f->GetArray()))
+            delete f->GetArray();
+        if (!keep.count(f))
+            DeleteFieldShell(f);
+    }
+    for (int i=0; i<input->GetNumCellSets(); ++i)
+    {
+        if (!keep.count(input->GetCellSet(i)))
+            delete input->GetCellSet(i);
+    }
+    DeleteDataSetShell(input);
+}
+
+// ****************************************************************************
+// Function:  FreeUnkeptDataSets
+//
+// Purpose:
+///   Free some data sets which may share parts with each other (e.g. the
+///   copy-on-write inputs of an operation on every chunk, and what it
+///   returned), and whatever of theirs the kept data sets don't use.
+///   Each part is freed once, however many of them use it.  Coordinate
+///   systems are left alone, as in FreeCopyOnWriteInput.
+//
+// Arguments:
+//   sets       the data sets to free; any may be NULL or repeated
+//   kept       the data sets whose parts must not be freed
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+FreeUnkeptDataSets(const std::vector<eavlDataSet*> &sets,
+                   const std::vector<eavlDataSet*> &kept)
+{
+    std::set<void*> keep;
+    for (size_t k=0; k<kept.size(); ++k)
+    {
+        if (!kept[k])
+            continue;
+        keep.insert(kept[k]);
+        for (int i=0; i<kept[k]->GetNumFields(); ++i)
+        {
+            keep.insert(kept[k]->GetField(i));
+            keep.insert(kept[k]->GetField(i)->GetArray());
+        }
+        for (int i=0; i<kept[k]->GetNumCellSets(); ++i)
+            keep.insert(kept[k]->GetCellSet(i));
+    }
+
+    // freeing a part adds it to keep, so nothing goes twice
+    for (size_t s=0; s<sets.size(); ++s)
+    {
+        eavlDataSet *ds = sets[s];
+        if (!ds || keep.count(ds))
+            continue;
+        for (int i=0; i<ds->GetNumFields(); ++i)
+        {
+            eavlField *f = ds->GetField(i);
+            if (keep.insert(f->GetArray()).second)
+                delete f->GetArray();
+            if (keep.insert(f).second)
+                DeleteFieldShell(f);
+        }
+        for (int i=0; i<ds->GetNumCellSets(); ++i)
+        {
+            if (keep.insert(ds->GetCellSet(i)).second)
+                delete ds->GetCellSet(i);
+        }
+        keep.insert(ds);
+        DeleteDataSetShell(ds);
+    }
+}
+
+// ****************************************************************************
+// Function:  DeleteDataSetShell
+//
+// Purpose:
+///   Delete a data set's own structure, but none of the fields, cell
+///   sets, coordinate systems, or logical structure it points to.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+DeleteDataSetShell(eavlDataSet *ds)
+{
+    DataSetShell::Empty(ds);
+    delete ds;
+}
+
+// ****************************************************************************
+// Function:  DeleteFieldShell
+//
+// Purpose:
+///   Delete a field, but not its array.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+DeleteFieldShell(eavlField *field)
+{
+    FieldShell::Empty(field);
+    delete field;
+}
+
+// ****************************************************************************
+// Function:  CopyArray
+//
+// Purpose:
+///   Deep copy of an array, keeping its name and its type where we know
+///   the type.  Anything we don't recognize becomes a float array.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlArray *
+CopyArray(eavlArray *arr)
+{
+    string name = arr->GetName();
+    int nc = arr->GetNumberOfComponents();
+    int nt = arr->GetNumberOfTuples();
+
+    eavlArray *copy;
+    if (dynamic_cast<eavlIntArray*>(arr))
+        copy = new eavlIntArray(name, nc, nt);
+    else if (dynamic_cast<eavlByteArray*>(arr))
+        copy = new eavlByteArray(name, nc, nt);
+    else
+        copy = new eavlFloatArray(name, nc, nt);
+
+    for (int i=0; i<nt; ++i)
+        for (int c=0; c<nc; ++c)
+            copy->SetComponentFromDouble(i, c, arr->GetComponentAsDouble(i, c));
+
+    return copy;
+}
+
+// ****************************************************************************
+// Function:  CopyField
+//
+// Purpose:
+///   Deep copy of a field and its array, with the same association.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlField *
+CopyField(eavlField *field)
+{
+    eavlArray *arr = CopyArray(field->GetArray());
+    switch (field->GetAssociation())
+    {
+      case eavlField::ASSOC_CELL_SET:
+        return new eavlField(field->GetOrder(), arr,
+                             eavlField::ASSOC_CELL_SET,
+                             field->GetAssocCellSet());
+      case eavlField::ASSOC_LOGICALDIM:
+        return new eavlField(field->GetOrder(), arr,
+                             eavlField::ASSOC_LOGICALDIM,
+                             field->GetAssocLogicalDim());
+      default:
+        return new eavlField(field->GetOrder(), arr,
+                             field->GetAssociation());
+    }
+}
+
+// ****************************************************************************
+// Function:  CopyCoordinates
+//
+// Purpose:
+///   Copy of a coordinate system.  The axes themselves only refer to
+///   fields (or are simple regular spacings), so the copy shares them;
+///   what it gets of its own is the list of axes and any transform, which
+///   is what the mutators change.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlCoordinates *
+CopyCoordinates(eavlCoordinates *cs)
+{
+    eavlCoordinatesCartesian *cart = dynamic_cast<eavlCoordinatesCartesian*>(cs);
+    if (cart)
+        return new eavlCoordinatesCartesian(*cart);
+
+    throw eavlException("can only copy Cartesian coordinate systems");
+}
+
+// ****************************************************************************
+// Function:  CopyCellSet
+//
+// Purpose:
+///   Deep copy of a cell set's connectivity.  The copy is always
+///   explicit, since that's the only kind we can build cell-by-cell.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlCellSet *
+CopyCellSet(eavlCellSet *cs)
+{
+    eavlExplicitConnectivity conn;
+    int ncells = cs->GetNumCells();
+    for (int i=0; i<ncells; ++i)
+    {
+        eavlCell cell = cs->GetCellNodes(i);
+        conn.AddElement(cell.type, cell.numIndices, cell.indices);
+    }
+
+    eavlCellSetExplicit *copy = new eavlCellSetExplicit(cs->GetName(),
+                                                        cs->GetDimensionality());
+    copy->SetCellNodeConnectivity(conn);
+    return copy;
+}
@@ -0,0 +1,47 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef COPY_ON_WRITE_H
+#define COPY_ON_WRITE_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "Operation.h"
+
+// ****************************************************************************
+// Functions for copy-on-write data sets between pipeline stages.
+//
+//   A pipeline keeps every intermediate result, and most of them share
+//   nearly all of their arrays with the stage before.  Before an operation
+//   executes, it gets a new data set which references all the same
+//   fields, cell sets, and coordinate systems as its input, except for
+//   the ones it says it will change; those are duplicated so the change
+//   doesn't leak back into the earlier results.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:22:08 EDT 2026
+//   Added freeing of the data set and field structures, without what
+//   they share.
+//
+//   Jeremy Meredith, Mon Oct 19 02:55:03 EDT 2026
+//   Added FreeUnkeptDataSets.
+//
+// ****************************************************************************
+
+eavlDataSet     *CreateCopyOnWriteInput(eavlDataSet *ds,
+                                        const DataSetParts &modified);
+void             FreeCopyOnWriteInput(eavlDataSet *ds, eavlDataSet *input,
+                                      eavlDataSet *output);
+void             FreeUnkeptDataSets(const std::vector<eavlDataSet*> &sets,
+                                    const std::vector<eavlDataSet*> &kept);
+
+void             DeleteDataSetShell(eavlDataSet *ds);
+void             DeleteFieldShell(eavlField *field);
+
+eavlArray       *CopyArray(eavlArray *arr);
+eavlField       *CopyField(eavlField *field);
+eavlCoordinates *CopyCoordinates(eavlCoordinates *cs);
+eavlCellSet     *CopyCellSet(eavlCellSet *cs);
+
+#endif
@@ -1,14 +1,12 @@
 #ifndef DS_INFO_H
 #define DS_INFO_H
 
+/// Just the structure; ask the Pipeline for the value ranges
+/// (GetFieldStats), since those are expensive to compute.
 struct FieldInfo
 {
     string name;
     int    ncomp;
-    double minval;
-    double maxval;
-    double minmag;
-    double maxmag;
 };
 
 ///\todo: we're not using PointsInfo yet in DSInfo
@@ -28,6 +26,8 @@ struct DSInfo
     vector<FieldInfo> nodalfields;
     vector<CellSetInfo> cellsets;
     map<string, vector<FieldInfo> > cellsetfields;
+    /// fields available from the source that haven't been read yet
+    vector<string> unloadedfields;
 
     void Print(std::ostream &out)
     {
@@ -54,7 +54,12 @@ struct DSInfo
 
             
         }
-        
+
+        out << "Not loaded:\n";
+        for (unsigned int i=0; i<unloadedfields.size(); i++)
+        {
+            out << "  " << unloadedfields[i] << endl;
+        }
     }
 };
 
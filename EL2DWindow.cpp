@@ -125,13 +125,14 @@ EL2DWindow::UpdatePlots()
     for (unsigned int i=0;  i<settings->plots.size(); i++)
     {
         Plot &p = settings->plots[i];
-        if (!p.pipe || p.pipe->results.size() == 0)
+        if (!p.pipe || p.pipe->output.size() == 0)
             continue;
         p.CreateEAVLPlot();
-        if (!p.eavlplot)
+        if (p.eavlplots.empty())
             continue;
         shoulddraw = true;
-        scene->plots.push_back(p.eavlplot);
+        scene->plots.insert(scene->plots.end(),
+                            p.eavlplots.begin(), p.eavlplots.end());
     }
     return shoulddraw;
 }
@@ -127,6 +127,27 @@ EL3DWindow::initializeGL()
 {
 }
 
+// ****************************************************************************
+// Method:  EL3DWindow::UpdatePlots
+//
+// Purpose:
+///   Make the scene's plots from the plot list.  While the mouse is
+///   down, we draw each plot's coarse proxy instead where it has one
+///   (see ProxyCache), so moving the view stays smooth however big the
+///   data is; letting go draws the full plots again.
+//
+// Arguments:
+//   none
+//
+// Programmer:  Jeremy Meredith
+// Creation:    August 16, 2012
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:14:37 EDT 2026
+//   Draw the proxies while the mouse is down, and start building them
+//   as soon as there's something to plot.
+//
+// ****************************************************************************
 bool
 EL3DWindow::UpdatePlots()
 {
@@ -136,17 +157,97 @@ EL3DWindow::UpdatePlots()
     for (unsigned int i=0;  i<settings->plots.size(); i++)
     {
         Plot &p = settings->plots[i];
-        if (!p.pipe || p.pipe->results.size() == 0)
+        if (!p.pipe || p.pipe->output.size() == 0)
             continue;
         p.CreateEAVLPlot();
-        if (!p.eavlplot)
+        if (p.eavlplots.empty())
             continue;
         shoulddraw = true;
-        scene->plots.push_back(p.eavlplot);
+        p.RequestProxies();
+        if (mousedown)
+        {
+            std::vector<eavlPlot*> drawn = p.GetInteractivePlots();
+            scene->plots.insert(scene->plots.end(),
+                                drawn.begin(), drawn.end());
+        }
+        else
+        {
+            scene->plots.insert(scene->plots.end(),
+                                p.eavlplots.begin(), p.eavlplots.end());
+        }
     }
     return shoulddraw;
 }
 
+// ****************************************************************************
+// Method:  EL3DWindow::GetRenderTransform
+//
+// Purpose:
+///   Get the transform the plots' pipelines leave for the renderer (see
+///   Pipeline::GetRenderTransform).  We apply it by moving the camera,
+///   so there's only one for the whole scene; if the plots disagree,
+///   or a pipeline's can't be applied, we don't apply any, and say why.
+//
+// Arguments:
+//   M          (output) the transform
+//   problem    (output) why we aren't applying one, or empty
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:04:15 EDT 2026
+//   Say why we aren't applying the transforms.
+//
+// ****************************************************************************
+bool
+EL3DWindow::GetRenderTransform(eavlMatrix4x4 &M, std::string &problem)
+{
+    bool found = false;
+    problem = "";
+    for (unsigned int i=0;  i<settings->plots.size(); i++)
+    {
+        Plot &p = settings->plots[i];
+        if (!p.pipe || p.eavlplots.empty())
+            continue;
+        eavlMatrix4x4 pm;
+        if (!p.pipe->GetRenderTransform(pm, problem))
+        {
+            if (!problem.empty())
+                return false;
+            pm.CreateIdentity();
+        }
+        if (!found)
+        {
+            M = pm;
+            found = true;
+            continue;
+        }
+        for (int r=0; r<4; ++r)
+        {
+            for (int c=0; c<4; ++c)
+            {
+                if (M(r,c) != pm(r,c))
+                {
+                    problem = "The plots have different transforms at "
+                              "render time, so none are applied.";
+                    return false;
+                }
+            }
+        }
+    }
+    if (!found)
+        return false;
+
+    eavlMatrix4x4 ident;
+    ident.CreateIdentity();
+    for (int r=0; r<4; ++r)
+        for (int c=0; c<4; ++c)
+            if (M(r,c) != ident(r,c))
+                return true;
+    return false;
+}
+
 // ****************************************************************************
 // Method:  EL3DWindow::ResetView
 //
@@ -187,6 +288,15 @@ EL3DWindow::ResetView()
 //   Jeremy Meredith, Thu Nov 29 12:19:33 EST 2012
 //   Added nodal surface normal lighting support.
 //
+//   Jeremy Meredith, Sun Oct 18 23:41:27 EDT 2026
+//   Apply render-time transforms to the camera for this paint.
+//
+//   Jeremy Meredith, Mon Oct 19 02:04:15 EDT 2026
+//   Show why, when we can't apply them.
+//
+//   Jeremy Meredith, Mon Oct 19 02:48:27 EDT 2026
+//   The transforms are for row vectors; transpose before applying.
+//
 // ****************************************************************************
 void
 EL3DWindow::paintGL()
@@ -207,8 +317,41 @@ EL3DWindow::paintGL()
         return;
 
     // okay, we think it's safe to proceed now!
-    
+
+    // transforms applied at render time move the camera the other way
+    // instead of touching the data
+    eavlView saved = window->view;
+    eavlMatrix4x4 M;
+    std::string problem;
+    if (GetRenderTransform(M, problem))
+    {
+        // the pipeline's matrices are for row vectors (p' = p*M), and
+        // eavlMatrix4x4 applies to column vectors
+        M.Invert();
+        eavlMatrix4x4 Mt;
+        for (int r=0; r<4; ++r)
+            for (int c=0; c<4; ++c)
+                Mt(r,c) = M(c,r);
+        M = Mt;
+        eavlView3D &v = window->view.view3d;
+        eavlVector3 unit = M * eavlVector3(1,0,0);
+        float scale = unit.norm();
+        v.from = M * v.from;
+        v.at   = M * v.at;
+        v.up   = M * v.up;
+        v.up.normalize();
+        v.nearplane *= scale;
+        v.farplane  *= scale;
+    }
     window->Paint();
+    window->view = saved;
+
+    if (!problem.empty())
+    {
+        eavlScreenTextAnnotation note(window, problem, eavlColor::white,
+                                      .035, -.95, -.95);
+        note.Render(window->view);
+    }
 
 
 #if 0
@@ -399,6 +542,9 @@ EL3DWindow::mouseMoveEvent(QMouseEvent *mev)
 // Creation:    August 15, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:14:37 EDT 2026
+//   Redraw, since we drew proxies while the mouse was down.
+//
 // ****************************************************************************
 void
 EL3DWindow::mouseReleaseEvent(QMouseEvent *)
@@ -407,7 +553,7 @@ EL3DWindow::mouseReleaseEvent(QMouseEvent *)
 
     mousedown = false;
     shiftKey = false;
-    //updateGL();
+    updateGL();
 }
 
 
@@ -31,6 +31,12 @@ class eavl3DAxisAnnotation;
 // Creation:    August 15, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 23:41:27 EDT 2026
+//   Added GetRenderTransform.
+//
+//   Jeremy Meredith, Mon Oct 19 02:04:15 EDT 2026
+//   GetRenderTransform says why it can't apply the transforms.
+//
 // ****************************************************************************
 class EL3DWindow : public QGLWidget
 {
@@ -50,6 +56,7 @@ class EL3DWindow : public QGLWidget
     void SetRendererOptions(Attribute*);
 
     QWidget *GetSettings();
+    bool GetRenderTransform(eavlMatrix4x4 &M, std::string &problem);
     /*
     virtual void contextMenuEvent(QContextMenuEvent*); 
 
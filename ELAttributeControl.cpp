@@ -8,12 +8,17 @@
 // Creation:    August 13, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Initialize the auto apply state.
+//
 // ****************************************************************************
 ELAttributeControl::ELAttributeControl(QWidget *parent, Qt::WindowFlags f)
     : QWidget(parent,f)
 {
     atts = NULL;
+    applyButton = NULL;
     created = false;
+    autoApply = false;
 }
 
 // ****************************************************************************
@@ -29,6 +34,9 @@ ELAttributeControl::ELAttributeControl(QWidget *parent, Qt::WindowFlags f)
 // Creation:    August 13, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Report edits as they happen, and hide Apply for auto apply.
+//
 // ****************************************************************************
 void
 ELAttributeControl::ConnectAttributes(Attribute *a)
@@ -74,6 +82,12 @@ ELAttributeControl::ConnectAttributes(Attribute *a)
             break;
         }
 
+        if (le)
+            connect(le, SIGNAL(textEdited(const QString&)),
+                    this, SIGNAL(settingsEdited()));
+        if (cb)
+            connect(cb, SIGNAL(clicked()),
+                    this, SIGNAL(settingsEdited()));
         lineEdits.push_back(le);
         checkBoxes.push_back(cb);
 
@@ -89,6 +103,30 @@ ELAttributeControl::ConnectAttributes(Attribute *a)
     layout->addWidget(applyButton, atts->GetNumFields(), 0);
     connect(applyButton, SIGNAL(clicked()),
             this, SLOT(UpdateAttsFromWindow()));
+    applyButton->setVisible(!autoApply);
+}
+
+// ****************************************************************************
+// Method:  ELAttributeControl::SetAutoApply
+//
+// Purpose:
+///   With auto apply, whoever listens to settingsEdited applies the
+///   edits when it's ready, so we hide the Apply button.
+//
+// Arguments:
+//   a          true for auto apply
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELAttributeControl::SetAutoApply(bool a)
+{
+    autoApply = a;
+    if (applyButton)
+        applyButton->setVisible(!autoApply);
 }
 
 // ****************************************************************************
@@ -105,6 +143,9 @@ ELAttributeControl::ConnectAttributes(Attribute *a)
 // Creation:    August 13, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:33:48 EDT 2026
+//   Show the held edits for the Attribute, if it has any.
+//
 // ****************************************************************************
 void
 ELAttributeControl::UpdateWindowFromAtts()
@@ -147,6 +188,10 @@ ELAttributeControl::UpdateWindowFromAtts()
         }
     }
 
+    std::map<Attribute*, std::vector<QString> >::iterator it =
+        heldEdits.find(atts);
+    if (it != heldEdits.end())
+        SetWindowValues(it->second);
 }
 
 // ****************************************************************************
@@ -163,6 +208,10 @@ ELAttributeControl::UpdateWindowFromAtts()
 // Creation:    August 13, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:33:48 EDT 2026
+//   Moved the conversion to SetAttsFromValues.  Any held edits for
+//   the Attribute are superseded.
+//
 // ****************************************************************************
 void
 ELAttributeControl::UpdateAttsFromWindow()
@@ -170,52 +219,169 @@ ELAttributeControl::UpdateAttsFromWindow()
     if (!atts || atts->GetNumFields() == 0)
         return;
 
-    for (int i=0; i<atts->GetNumFields(); i++)
+    heldEdits.erase(atts);
+    SetAttsFromValues(atts, GetWindowValues());
+
+    // debug
+    //cout << "\n\n -- after update, the new settings are: --\n\n";
+    //atts->XMLSerialize(cout);
+    //cout << endl;
+
+    // They might have e.g. put chars into a numerical field, or added
+    // values to a non-resizable field; we don't want to allow that.
+    UpdateWindowFromAtts();
+
+    emit settingsChanged(atts);
+}
+
+
+// ****************************************************************************
+// Method:  ELAttributeControl::SetAttsFromValues
+//
+// Purpose:
+///   Set an Attribute from the contents of our controls (see
+///   GetWindowValues), which needn't be the ones it's showing.
+//
+// Arguments:
+//   a          an Attribute of the type we were created for
+//   values     the contents of the controls, per field
+//
+// Programmer:  Jeremy Meredith
+// Creation:    August 13, 2012
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:33:48 EDT 2026
+//   Split out of UpdateAttsFromWindow.
+//
+// ****************************************************************************
+void
+ELAttributeControl::SetAttsFromValues(Attribute *a,
+                                      const std::vector<QString> &values)
+{
+    for (int i=0; i<a->GetNumFields() && i<(int)values.size(); i++)
     {
-        QLineEdit *le = lineEdits[i];
-        QCheckBox *cb = checkBoxes[i];
-        int len = atts->GetFieldLength(i);
-        if (le)
+        int len = a->GetFieldLength(i);
+        if (lineEdits[i])
         {
-            if (atts->GetFieldTypeCategory(i) == CategoryString)
+            if (a->GetFieldTypeCategory(i) == CategoryString)
             {
                 if (len == 1)
-                    atts->SetFieldFromString(le->text().toStdString(), i);
+                    a->SetFieldFromString(values[i].toStdString(), i);
                 else
                     cerr << "Error: don't yet handle arr/vec of strings\n";
             }
             else
             {
-                QStringList sl  = le->text().split(QRegExp("[, \t]"),
-                                                   QString::SkipEmptyParts);
+                QStringList sl  = values[i].split(QRegExp("[, \t]"),
+                                                  QString::SkipEmptyParts);
                 // try to resize the field length (wors only for vectors)
-                try { atts->SetFieldLength(i, sl.size()); } catch(...) { }
-                len = atts->GetFieldLength(i);
+                try { a->SetFieldLength(i, sl.size()); } catch(...) { }
+                len = a->GetFieldLength(i);
                 for (int j=0; j<sl.size(); j++)
                 {
                     if (j < len)
-                        atts->SetFieldFromDouble(sl[j].toDouble(), i, j);
+                        a->SetFieldFromDouble(sl[j].toDouble(), i, j);
                 }
             }
         }
-        else if (cb)
+        else if (checkBoxes[i])
         {
             if (len == 1)
-                atts->SetFieldFromLong(cb->isChecked(), i);
+                a->SetFieldFromLong(values[i] == "1", i);
             else
                 cerr << "Error: don't yet handle arr/vec of bools\n";
         }
     }
+}
+
+// ****************************************************************************
+// Method:  ELAttributeControl::GetWindowValues
+//
+// Purpose:
+///   The contents of our controls, per field: the text of a box, or
+///   "1" or "0" for a check box.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::vector<QString>
+ELAttributeControl::GetWindowValues()
+{
+    std::vector<QString> values(lineEdits.size());
+    for (size_t i=0; i<lineEdits.size(); i++)
+    {
+        if (lineEdits[i])
+            values[i] = lineEdits[i]->text();
+        else if (checkBoxes[i])
+            values[i] = checkBoxes[i]->isChecked() ? "1" : "0";
+    }
+    return values;
+}
 
-    // debug
-    //cout << "\n\n -- after update, the new settings are: --\n\n";
-    //atts->XMLSerialize(cout);
-    //cout << endl;
+void
+ELAttributeControl::SetWindowValues(const std::vector<QString> &values)
+{
+    for (size_t i=0; i<lineEdits.size() && i<values.size(); i++)
+    {
+        if (lineEdits[i])
+            lineEdits[i]->setText(values[i]);
+        else if (checkBoxes[i])
+            checkBoxes[i]->setChecked(values[i] == "1");
+    }
+}
 
-    // They might have e.g. put chars into a numerical field, or added
-    // values to a non-resizable field; we don't want to allow that.
-    UpdateWindowFromAtts();
+// ****************************************************************************
+// Method:  ELAttributeControl::HoldEdits
+//
+// Purpose:
+///   Remember the contents of the controls for the Attribute they're
+///   showing, to apply later even if they move on to another one.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELAttributeControl::HoldEdits()
+{
+    if (!atts || atts->GetNumFields() == 0)
+        return;
+    heldEdits[atts] = GetWindowValues();
+}
 
-    emit settingsChanged(atts);
+// ****************************************************************************
+// Method:  ELAttributeControl::ApplyHeldEdits
+//
+// Purpose:
+///   Apply the held edits, each to its own Attribute, and emit
+///   settingsChanged for each.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELAttributeControl::ApplyHeldEdits()
+{
+    std::map<Attribute*, std::vector<QString> > held;
+    held.swap(heldEdits);
+    std::map<Attribute*, std::vector<QString> >::iterator it;
+    for (it = held.begin(); it != held.end(); ++it)
+    {
+        SetAttsFromValues(it->first, it->second);
+        if (it->first == atts)
+            UpdateWindowFromAtts();
+        emit settingsChanged(it->first);
+    }
 }
 
+void
+ELAttributeControl::DropHeldEdits()
+{
+    heldEdits.clear();
+    UpdateWindowFromAtts();
+}
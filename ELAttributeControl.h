@@ -16,12 +16,29 @@
 // Class:  ELAttributeControl
 //
 // Purpose:
-///   Creates a set of controls for any given Attribute.
+///   Creates a set of controls for any given Attribute.  Any edit to
+///   the controls emits settingsEdited(); the settings themselves only
+///   change when they're applied, by the Apply button or, with auto
+///   apply, by whoever is listening calling UpdateAttsFromWindow.
+///
+///   One set of controls is shared by every Attribute of a type, so
+///   edits which can't be applied yet are held for their own Attribute
+///   when the controls move on to another (see HoldEdits), and applied
+///   to it later (see ApplyHeldEdits).
 //
 // Programmer:  Jeremy Meredith
 // Creation:    August 13, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   UpdateWindowFromAtts is virtual so subclasses can add controls.
+//
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Added settingsEdited and SetAutoApply.
+//
+//   Jeremy Meredith, Mon Oct 19 02:33:48 EDT 2026
+//   Added held edits.
+//
 // ****************************************************************************
 class ELAttributeControl : public QWidget
 {
@@ -33,14 +50,27 @@ class ELAttributeControl : public QWidget
     QPushButton *applyButton;
     QGridLayout *layout;
     bool created;
+    bool autoApply;
+    /// the contents of the controls, per field, for each Attribute with
+    /// edits waiting to be applied
+    std::map<Attribute*, std::vector<QString> > heldEdits;
+
+    std::vector<QString> GetWindowValues();
+    void SetWindowValues(const std::vector<QString> &values);
+    void SetAttsFromValues(Attribute *a, const std::vector<QString> &values);
   public:
     ELAttributeControl(QWidget *parent, Qt::WindowFlags f = 0);
     virtual void ConnectAttributes(Attribute *a);
+    void SetAutoApply(bool);
+    void HoldEdits();
+    void ApplyHeldEdits();
+    void DropHeldEdits();
   public slots:
-    void UpdateWindowFromAtts();
+    virtual void UpdateWindowFromAtts();
     void UpdateAttsFromWindow();
   signals:
     void settingsChanged(Attribute*);
+    void settingsEdited();
 };
 
 
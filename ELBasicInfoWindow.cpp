@@ -11,6 +11,9 @@
 // Creation:    August  3, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:44:03 EDT 2026
+//   Added the checkbox to show field ranges.
+//
 // ****************************************************************************
 ELBasicInfoWindow::ELBasicInfoWindow(ELWindowManager *parent)
     : QWidget(parent)
@@ -26,7 +29,13 @@ ELBasicInfoWindow::ELBasicInfoWindow(ELWindowManager *parent)
     //info->installEventFilter(this); <- to catch focus.  Sadly,
     // this doesn't work; events like mouse press aren't getting to the 
     // filter (and it's not just because of read-only!)
-    topLayout->addWidget(info);
+    topLayout->addWidget(info, 0, 0);
+
+    showRanges = new QCheckBox("Show field ranges", this);
+    showRanges->setChecked(false);
+    connect(showRanges, SIGNAL(toggled(bool)),
+            this, SLOT(SomethingChanged()));
+    topLayout->addWidget(showRanges, 1, 0);
 
     GetSettings();
 }
@@ -67,12 +76,27 @@ ELBasicInfoWindow::PipelineUpdated(Pipeline *p)
 // Creation:    August 21, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 13:40:02 EDT 2026
+//   Results are per chunk now; summarize the first one.
+//
+//   Jeremy Meredith, Sun Oct 18 15:02:37 EDT 2026
+//   Show the published output.
+//
+//   Jeremy Meredith, Sun Oct 18 21:17:52 EDT 2026
+//   Show the field ranges.
+//
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   There may not be a pipeline chosen yet.
+//
+//   Jeremy Meredith, Mon Oct 19 01:44:03 EDT 2026
+//   Only compute the field ranges if they're asked for.
+//
 // ****************************************************************************
 void
 ELBasicInfoWindow::FillFromPipeline(Pipeline *p)
 {
     info->clear();
-    if (p->source->file.empty())
+    if (!p || p->source->file.empty())
         return;
 
     Source *s = p->source;
@@ -110,11 +134,30 @@ ELBasicInfoWindow::FillFromPipeline(Pipeline *p)
                          QString::number(importer->GetMeshList().size()) 
                           + " meshes<br>");
     }
-    if (p->results.size() > 0)
+    if (p->output.size() > 0)
     {
         info->insertHtml("<br><b>Execution Result Follows:</b><br><br>");
         ostringstream out;
-        p->results.back()->PrintSummary(out);
+        if (p->output.size() > 1)
+            out << "Chunk 0 of " << p->output.size() << ":" << endl;
+        p->output[0]->PrintSummary(out);
+
+        if (showRanges->isChecked())
+        {
+            out << endl << "Field ranges (over all chunks):" << endl;
+            eavlDataSet *ds = p->output[0];
+            for (int i=0; i<ds->GetNumFields(); ++i)
+            {
+                eavlArray *arr = ds->GetField(i)->GetArray();
+                FieldStats stats = p->GetFieldStats(arr->GetName());
+                out << "  " << arr->GetName() << ": "
+                    << stats.minval << " to " << stats.maxval;
+                if (arr->GetNumberOfComponents() > 1)
+                    out << " (magnitude " << stats.minmag
+                        << " to " << stats.maxmag << ")";
+                out << endl;
+            }
+        }
         info->insertPlainText(out.str().c_str());
     }
 }
@@ -4,6 +4,7 @@
 
 #include "ELWindowManager.h"
 
+#include <QCheckBox>
 #include <QTextEdit>
 
 class Pipeline;
@@ -48,7 +49,10 @@ class ELPipelineChooser : public QWidget
     }
     Pipeline *GetPipeline()
     {
-        return Pipeline::allPipelines[pipelineCombo->currentIndex()];
+        int index = pipelineCombo->currentIndex();
+        if (index < 0 || index >= (int)Pipeline::allPipelines.size())
+            return NULL;
+        return Pipeline::allPipelines[index];
     }
   public slots:
     void PipelineSelected(const QString &)
@@ -63,18 +67,24 @@ class ELPipelineChooser : public QWidget
 // Class:  ELBasicInfoWindow
 //
 // Purpose:
-///   Output window containing basic info about the source.
+///   Output window containing basic info about the source.  Field
+///   ranges mean a pass over every value of every field, so they're
+///   only shown when asked for.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    August  3, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:44:03 EDT 2026
+//   Added the checkbox to show field ranges.
+//
 // ****************************************************************************
 class ELBasicInfoWindow : public QWidget
 {
     Q_OBJECT
   protected:
     QTextEdit     *info;
+    QCheckBox     *showRanges;
     ELPipelineChooser *settings;
   public:
     ELBasicInfoWindow(ELWindowManager *parent);
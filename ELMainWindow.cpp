@@ -26,6 +26,12 @@
 // Creation:    July 30, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Execute what the windows need when that changes.
+//
+//   Jeremy Meredith, Mon Oct 19 03:02:37 EDT 2026
+//   Pipeline updates go through the window manager.
+//
 // ****************************************************************************
 ELMainWindow::ELMainWindow(QWidget *parent) :
     QMainWindow(parent)
@@ -74,6 +80,18 @@ ELMainWindow::ELMainWindow(QWidget *parent) :
             this, SLOT(WindowAdded(QWidget*)));
     connect(windowMgr, SIGNAL(SettingsActivated(QWidget*)),
             this, SLOT(SettingsActivated(QWidget*)));
+    // the window manager knows which windows are showing
+    connect(pipelineBuilder, SIGNAL(pipelineUpdated(Pipeline*)),
+            windowMgr, SLOT(PipelineUpdated(Pipeline*)));
+    // queued, since demand often changes while we're in the middle of
+    // telling the windows about a finished execution
+    connect(windowMgr, SIGNAL(DemandChanged()),
+            pipelineBuilder, SLOT(executeDemanded()),
+            Qt::QueuedConnection);
+    // a plot may have wanted a variable while its pipeline was busy
+    connect(pipelineBuilder, SIGNAL(pipelineUpdated(Pipeline*)),
+            windowMgr, SLOT(UpdateDemand()),
+            Qt::QueuedConnection);
 
     topSplitter->setStretchFactor(0,40);
     topSplitter->setStretchFactor(1,1);
@@ -239,12 +257,13 @@ ELMainWindow::PipelineUpdated(Pipeline *)
 // Creation:    August  7, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 03:02:37 EDT 2026
+//   The window manager passes pipeline updates on to the windows now.
+//
 // ****************************************************************************
 void
 ELMainWindow::WindowAdded(QWidget *w)
 {
-    connect(pipelineBuilder, SIGNAL(pipelineUpdated(Pipeline*)),
-            w, SLOT(PipelineUpdated(Pipeline*)));    
     connect(pipelineBuilder, SIGNAL(CurrentPipelineChanged(int)),
             w, SLOT(CurrentPipelineChanged(int)));
 }
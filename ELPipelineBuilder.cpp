@@ -12,18 +12,23 @@
 #include <QComboBox>
 #include <QLabel>
 #include <QMessageBox>
+#include <QFileDialog>
+#include <QProgressBar>
+#include <QCheckBox>
+#include <QTimer>
+
+#include <algorithm>
+#include <fstream>
 
 #include "Operation.h"
 #include "ELAttributeControl.h"
+#include "ELScrubControl.h"
 #include "ELSources.h"
+#include "PipelineThread.h"
 
-#include "ExternalFaceOperation.h"
-#include "ElevateOperation.h"
-#include "IsosurfaceOperation.h"
-#include "HistogramOperation.h"
-#include "SurfaceNormalsOperation.h"
-#include "ThresholdOperation.h"
-#include "TransformOperation.h"
+/// How long the settings must sit still before auto-execute applies
+/// them, in milliseconds.
+static const int autoExecuteDelay = 300;
 
 // ****************************************************************************
 // Constructor:  ELPipelineBuilder::ELPipelineBuilder
@@ -32,11 +37,52 @@
 // Creation:    August  2, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 15:02:37 EDT 2026
+//   Added the execution thread, progress bar, and cancel button.
+//
+//   Jeremy Meredith, Sun Oct 18 19:10:26 EDT 2026
+//   Added profiling columns to the tree.
+//
+//   Jeremy Meredith, Sun Oct 18 20:05:44 EDT 2026
+//   Added a button to save the current pipeline.
+//
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   Initialize the slider scrubbing state.
+//
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Added the branch button, and opening a branch from the tree.
+//
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Initialize the demand-driven execution state.
+//
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Added the auto-execute check box and its timer.
+//
+//   Jeremy Meredith, Mon Oct 19 03:16:42 EDT 2026
+//   Build the operator menu from Pipeline::GetOperationNames.
+//
 // ****************************************************************************
 ELPipelineBuilder::ELPipelineBuilder(QWidget *parent)
     : QWidget(parent)
 {
     currentPipeline = -1;
+    scrubControl = NULL;
+    scrubbing = false;
+    scrubPending = false;
+    demandPending = false;
+    autoPending = false;
+
+    autoExecuteTimer = new QTimer(this);
+    autoExecuteTimer->setSingleShot(true);
+    autoExecuteTimer->setInterval(autoExecuteDelay);
+    connect(autoExecuteTimer, SIGNAL(timeout()),
+            this, SLOT(autoExecute()));
+
+    executor = new PipelineThread(this);
+    connect(executor, SIGNAL(progress(int,int,const QString&)),
+            this, SLOT(executionProgress(int,int,const QString&)));
+    connect(executor, SIGNAL(finished()),
+            this, SLOT(executionFinished()));
 
     // Top layout
     QGridLayout *topLayout = new QGridLayout(this);
@@ -51,6 +97,11 @@ ELPipelineBuilder::ELPipelineBuilder(QWidget *parent)
     connect(newPipelineBtn, SIGNAL(clicked()),
             this, SLOT(NewPipeline()));
 
+    QPushButton *savePipelineBtn = new QPushButton("Save Pipeline", this);
+    topLayout->addWidget(savePipelineBtn, 2,0, 1,2);
+    connect(savePipelineBtn, SIGNAL(clicked()),
+            this, SLOT(SavePipeline()));
+
     QSplitter *topSplitter = new QSplitter(Qt::Vertical, this);
     topLayout->addWidget(topSplitter, 3, 0, 1, 2);
 
@@ -63,54 +114,72 @@ ELPipelineBuilder::ELPipelineBuilder(QWidget *parent)
     // The pipeline tree
     //
     tree = new QTreeWidget(pipelineGroup);
-    tree->setHeaderLabels(QStringList() << "Operation" << "Settings");
+    tree->setHeaderLabels(QStringList() << "Operation" << "Settings"
+                          << "Wall (s)" << "CPU (s)" << "Mem (+MB)"
+                          << "Points" << "Cells");
     //tree->setHeaderHidden(true);
     pipelineLayout->addWidget(tree, 0,0);
     connect(tree, SIGNAL(itemSelectionChanged()),
             this, SLOT(rowSelected()));
+    connect(tree, SIGNAL(itemDoubleClicked(QTreeWidgetItem*,int)),
+            this, SLOT(branchActivated(QTreeWidgetItem*)));
 
     //
     // The operator menu
     //
     QMenu *opMenu = new QMenu();
-    ///\todo: these choice names must currently match the exact text in
-    /// Operation::GetOperationName.  We should loosed this restriction.
-    const char *operations[] = {
-        "Isosurface",
-        "Elevate",
-        "ExternalFace",
-        "Histogram",
-        "SurfaceNormals",
-        "Threshold",
-        "Transform",
-        NULL
-    };
-    for (int i=0; operations[i] != NULL; i++)
+    std::vector<std::string> operations = Pipeline::GetOperationNames();
+    for (size_t i=0; i<operations.size(); i++)
     {
-        QAction *op= opMenu->addAction(operations[i]);
-        op->setData(QString(operations[i]));
+        QString name(operations[i].c_str());
+        QAction *op= opMenu->addAction(name);
+        op->setData(name);
         connect(op, SIGNAL(triggered()), this, SLOT(newOperation()));
     }
-    QPushButton *addOpButton = new QPushButton("Add Operation", pipelineGroup);
+    addOpButton = new QPushButton("Add Operation", pipelineGroup);
     addOpButton->setMenu(opMenu);
     pipelineLayout->addWidget(addOpButton, 1,0);
 
     //
     // add execute button (probably not the best place for it)
     //
-    QPushButton *deleteOpButton = new QPushButton("Delete Operation", pipelineGroup);
+    deleteOpButton = new QPushButton("Delete Operation", pipelineGroup);
     pipelineLayout->addWidget(deleteOpButton, 2, 0);
     connect(deleteOpButton, SIGNAL(clicked()),
             this, SLOT(deleteCurrentOp()));
 
+    //
+    // start a new pipeline from the selected stage
+    //
+    branchButton = new QPushButton("Branch From Here", pipelineGroup);
+    pipelineLayout->addWidget(branchButton, 3, 0);
+    connect(branchButton, SIGNAL(clicked()),
+            this, SLOT(branchPipeline()));
+
 
     //
     // add execute button (probably not the best place for it)
     //
-    QPushButton *executeButton = new QPushButton("Execute", pipelineGroup);
-    pipelineLayout->addWidget(executeButton, 3, 0);
+    executeButton = new QPushButton("Execute", pipelineGroup);
+    pipelineLayout->addWidget(executeButton, 4, 0);
     connect(executeButton, SIGNAL(clicked()),
             this, SLOT(executePipeline()));
+    autoExecuteBox = new QCheckBox("Execute Automatically", pipelineGroup);
+    pipelineLayout->addWidget(autoExecuteBox, 5, 0);
+    connect(autoExecuteBox, SIGNAL(toggled(bool)),
+            this, SLOT(autoExecuteToggled(bool)));
+
+    //
+    // progress and cancel, only shown while executing
+    //
+    progressBar = new QProgressBar(pipelineGroup);
+    pipelineLayout->addWidget(progressBar, 6, 0);
+    progressBar->hide();
+    cancelButton = new QPushButton("Cancel", pipelineGroup);
+    pipelineLayout->addWidget(cancelButton, 7, 0);
+    connect(cancelButton, SIGNAL(clicked()),
+            this, SLOT(cancelExecution()));
+    cancelButton->hide();
 
     //
     // Settings
@@ -135,6 +204,23 @@ ELPipelineBuilder::ELPipelineBuilder(QWidget *parent)
     pipelineChooser->addItem("");
 }
 
+// ****************************************************************************
+// Destructor:  ELPipelineBuilder::~ELPipelineBuilder
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:10:37 EDT 2026
+//   Cancel doesn't wait any more, so wait here.
+//
+// ****************************************************************************
+ELPipelineBuilder::~ELPipelineBuilder()
+{
+    // the thread can't be destroyed while it's running
+    executor->Cancel();
+    executor->wait();
+}
 
 void
 ELPipelineBuilder::NewPipeline()
@@ -147,6 +233,42 @@ ELPipelineBuilder::NewPipeline()
     activatePipeline(Pipeline::allPipelines.size()-1);
 }
 
+// ****************************************************************************
+// Method:  ELPipelineBuilder::SavePipeline
+//
+// Purpose:
+///   Slot to save the current pipeline to a file, e.g. to execute it
+///   later with "eavlab -batch".
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::SavePipeline()
+{
+    if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
+        return;
+    Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
+
+    QString fn = QFileDialog::getSaveFileName(this, "Save Pipeline", "",
+                                              "Pipelines (*.xml)");
+    if (fn.isEmpty())
+        return;
+
+    try
+    {
+        ofstream out(fn.toStdString().c_str());
+        pipeline->Save(out);
+    }
+    catch (const eavlException &e)
+    {
+        QMessageBox::warning(this, "Save Pipeline",
+                             e.GetErrorText().c_str());
+    }
+}
+
 void ELPipelineBuilder::UpdatePipelineCombo()
 {
     for (unsigned int i=0; i<Pipeline::allPipelines.size(); i++)
@@ -171,6 +293,12 @@ void ELPipelineBuilder::UpdatePipelineCombo()
 // Creation:    August  7, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 19:10:26 EDT 2026
+//   Show the profiling stats.
+//
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Show the branches under the stages they start from.
+//
 // ****************************************************************************
 void
 ELPipelineBuilder::rebuildPipelineDisplay()
@@ -185,6 +313,7 @@ ELPipelineBuilder::rebuildPipelineDisplay()
     sourceItem->setText(0, pipeline->source->GetSourceType().c_str());
     sourceItem->setText(1, pipeline->source->GetSourceInfo().c_str());
     tree->addTopLevelItem(sourceItem);
+    std::vector<QTreeWidgetItem*> stageItems(1, sourceItem);
 
     for (unsigned int i=0; i<pipeline->ops.size(); ++i)
     {
@@ -192,11 +321,131 @@ ELPipelineBuilder::rebuildPipelineDisplay()
         opitem->setText(0, pipeline->ops[i]->GetOperationName().c_str());
         opitem->setText(1, pipeline->ops[i]->GetOperationInfo().c_str());
         tree->addTopLevelItem(opitem);
+        stageItems.push_back(opitem);
     }
 
+    AddBranchItems(pipeline, stageItems);
+    tree->expandAll();
+
+    UpdateStatsDisplay();
+
     tree->setCurrentItem(sourceItem);
 }
 
+// ****************************************************************************
+// Method:  ELPipelineBuilder::AddBranchItems
+//
+// Purpose:
+///   Add the branches of a pipeline to the tree, each one as a child of
+///   the item for the stage it starts from, with its operations under
+///   it, and so on for their branches.  Only the current pipeline's
+///   own stages are top level items; double-clicking anything in a
+///   branch switches to editing that branch.
+//
+// Arguments:
+//   pipeline   the pipeline whose branches to add
+//   stageItems the item for each of its stages
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::AddBranchItems(Pipeline *pipeline,
+                                  const std::vector<QTreeWidgetItem*> &stageItems)
+{
+    std::vector<Pipeline*> branches = pipeline->GetBranches();
+    for (size_t b=0; b<branches.size(); ++b)
+    {
+        Pipeline *branch = branches[b];
+        int index = std::find(Pipeline::allPipelines.begin(),
+                              Pipeline::allPipelines.end(), branch) -
+                    Pipeline::allPipelines.begin();
+
+        QTreeWidgetItem *branchItem =
+            new QTreeWidgetItem(stageItems[branch->GetSourcePipeStage()]);
+        branchItem->setText(0, "Branch");
+        branchItem->setText(1, branch->GetName().c_str());
+        branchItem->setData(0, Qt::UserRole, index);
+        std::vector<QTreeWidgetItem*> branchStages(1, branchItem);
+
+        for (unsigned int i=0; i<branch->ops.size(); ++i)
+        {
+            QTreeWidgetItem *opitem = new QTreeWidgetItem(branchItem);
+            opitem->setText(0, branch->ops[i]->GetOperationName().c_str());
+            opitem->setText(1, branch->ops[i]->GetOperationInfo().c_str());
+            opitem->setData(0, Qt::UserRole, index);
+            branchStages.push_back(opitem);
+        }
+
+        AddBranchItems(branch, branchStages);
+    }
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::UpdateStatsDisplay
+//
+// Purpose:
+///   Fill in the profiling columns in the tree from the last execution
+///   of the current pipeline.  Stages which didn't execute (because we
+///   already had their results) are left blank, and ones which came
+///   from another pipeline's results are marked as cached.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::UpdateStatsDisplay()
+{
+    if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
+        return;
+    Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
+
+    for (int row=0; row<tree->topLevelItemCount(); ++row)
+    {
+        QTreeWidgetItem *item = tree->topLevelItem(row);
+        for (int col=2; col<7; ++col)
+            item->setText(col, "");
+
+        StageStats s = pipeline->GetStageStats(row);
+        if (s.computed == 0 && s.cached == 0)
+            continue;
+
+        if (s.computed == 0)
+        {
+            item->setText(2, "(cached)");
+        }
+        else
+        {
+            item->setText(2, QString::number(s.wall, 'f', 3));
+            item->setText(3, QString::number(s.cpu, 'f', 3));
+            item->setText(4, QString::number(s.peakMemoryMB, 'f', 1));
+        }
+        if (row == 0)
+            item->setText(5, QString::number(s.outPoints));
+        else
+            item->setText(5, QString::number(s.inPoints) + " > " +
+                             QString::number(s.outPoints));
+        if (row == 0)
+            item->setText(6, QString::number(s.outCells));
+        else
+            item->setText(6, QString::number(s.inCells) + " > " +
+                             QString::number(s.outCells));
+
+        // only the chunks this execution touched are counted
+        if (s.computed + s.cached < s.nchunks)
+        {
+            QString note = QString("%1 of %2 chunks executed")
+                .arg(s.computed + s.cached).arg(s.nchunks);
+            for (int col=2; col<7; ++col)
+                item->setToolTip(col, note);
+        }
+    }
+}
+
 // ****************************************************************************
 // Method:  ELPipelineBuilder::activatePipeline
 //
@@ -210,16 +459,80 @@ ELPipelineBuilder::rebuildPipelineDisplay()
 // Creation:    August  7, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Apply any edits waiting to auto-execute first.
+//
 // ****************************************************************************
 void
 ELPipelineBuilder::activatePipeline(int index)
 {
+    FlushAutoExecute();
     currentPipeline = index;
     rebuildPipelineDisplay();
     emit CurrentPipelineChanged(index);
 }
 
 
+// ****************************************************************************
+// Method:  ELPipelineBuilder::GetSettingsWidget
+//
+// Purpose:
+///   Get the settings widget for an operation type, creating it the
+///   first time.  Isosurfaces get a slider for the isovalue, and
+///   thresholds get sliders for the ends of their range.
+//
+// Arguments:
+//   name       the operation name
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:54:06 EDT 2026
+//   Added the threshold range sliders.
+//
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Watch for edits, for auto-execute.
+//
+// ****************************************************************************
+QWidget *
+ELPipelineBuilder::GetSettingsWidget(const QString &name)
+{
+    QWidget *opSettingsWidget = opSettingsWidgets[name];
+    if (opSettingsWidget)
+        return opSettingsWidget;
+
+    if (name == "Isosurface")
+    {
+        opSettingsWidget = new ELScrubControl(settingsGroup, "field",
+                                      std::vector<std::string>(1, "value"));
+        connect(opSettingsWidget, SIGNAL(scrubbed()),
+                this, SLOT(operatorScrubbed()));
+    }
+    else if (name == "Threshold")
+    {
+        std::vector<std::string> ends;
+        ends.push_back("Minimum value");
+        ends.push_back("Maximum value");
+        opSettingsWidget = new ELScrubControl(settingsGroup, "Field name",
+                                              ends);
+        connect(opSettingsWidget, SIGNAL(scrubbed()),
+                this, SLOT(operatorScrubbed()));
+    }
+    else
+    {
+        opSettingsWidget = new ELAttributeControl(settingsGroup);
+    }
+    opSettingsWidgets[name] = opSettingsWidget;
+    connect(opSettingsWidget, SIGNAL(settingsChanged(Attribute*)),
+            this, SLOT(operatorUpdated(Attribute*)));
+    connect(opSettingsWidget, SIGNAL(settingsEdited()),
+            this, SLOT(operatorEdited()));
+    ((ELAttributeControl*)opSettingsWidget)->SetAutoApply(
+                                               autoExecuteBox->isChecked());
+    return opSettingsWidget;
+}
+
 // ****************************************************************************
 // Method:  ELPipelineBuilder::newOperation
 //
@@ -230,6 +543,12 @@ ELPipelineBuilder::activatePipeline(int index)
 // Creation:    August  7, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 20:05:44 EDT 2026
+//   Use Pipeline::CreateOperation.
+//
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   Moved the settings widget creation to GetSettingsWidget.
+//
 // ****************************************************************************
 void
 ELPipelineBuilder::newOperation()
@@ -244,31 +563,12 @@ ELPipelineBuilder::newOperation()
 
     QString actionname = action->data().toString();
 
-    QWidget *opSettingsWidget = opSettingsWidgets[actionname];
-    if (opSettingsWidget == NULL)
-    {
-        opSettingsWidget = new ELAttributeControl(settingsGroup);
-        opSettingsWidgets[actionname] = opSettingsWidget;
-        connect(opSettingsWidget, SIGNAL(settingsChanged(Attribute*)),
-                this, SLOT(operatorUpdated(Attribute*)));
-    }
+    QWidget *opSettingsWidget = GetSettingsWidget(actionname);
 
-    if (actionname == "Isosurface")
-        pipeline->ops.push_back(new IsosurfaceOperation);
-    else if (actionname == "Elevate")
-        pipeline->ops.push_back(new ElevateOperation);
-    else if (actionname == "ExternalFace")
-        pipeline->ops.push_back(new ExternalFaceOperation);
-    else if (actionname == "Histogram")
-        pipeline->ops.push_back(new HistogramOperation);
-    else if (actionname == "SurfaceNormals")
-        pipeline->ops.push_back(new SurfaceNormalsOperation);
-    else if (actionname == "Threshold")
-        pipeline->ops.push_back(new ThresholdOperation);
-    else if (actionname == "Transform")
-        pipeline->ops.push_back(new TransformOperation);
-    else
+    Operation *op = Pipeline::CreateOperation(actionname.toStdString());
+    if (!op)
         throw "Unexpected operation";
+    pipeline->ops.push_back(op);
 
     opSettingsWidget->hide();
 
@@ -306,10 +606,22 @@ ELPipelineBuilder::addSource(const std::string &fn, eavlImporter *imp)
 // Creation:    August  7, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   Create the settings widget if needed, e.g. for a loaded pipeline,
+//   and set the range of any sliders.
+//
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Ignore the items showing branches.
+//
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Apply any edits waiting to auto-execute first.
+//
 // ****************************************************************************
 void
 ELPipelineBuilder::rowSelected()
 {
+    FlushAutoExecute();
+
     if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
         return;
 
@@ -328,6 +640,8 @@ ELPipelineBuilder::rowSelected()
     else
     {
         QTreeWidgetItem *item = s[0];
+        if (item->parent())
+            return;
         QLayoutItem *oldSettingsLI = settingsGroup->layout()->takeAt(0);
         if (oldSettingsLI)
         {
@@ -347,9 +661,7 @@ ELPipelineBuilder::rowSelected()
         {
             int opindex = rowindex-1;
             QString name = item->text(0);
-            QWidget *newSettingsWidget = opSettingsWidgets[name];
-            if (!newSettingsWidget)
-                cerr << "FATAL Error: didn't get settings with name="<<name.toStdString()<<endl;
+            QWidget *newSettingsWidget = GetSettingsWidget(name);
             ELAttributeControl *controls = dynamic_cast<ELAttributeControl*>(newSettingsWidget);
             if (!controls)
                 throw "eh?";
@@ -363,6 +675,7 @@ ELPipelineBuilder::rowSelected()
             controls->UpdateWindowFromAtts();
             settingsGroup->layout()->addWidget(newSettingsWidget);
             newSettingsWidget->show();
+            UpdateScrubRange();
         }
     }
     
@@ -372,7 +685,8 @@ ELPipelineBuilder::rowSelected()
 // Method:  ELPipelineBuilder::executePipeline
 //
 // Purpose:
-///   Execute the active pipeline and update any watchers via a signal.
+///   Start executing the active pipeline.  When it's done, we update
+///   any watchers via a signal (see executionFinished).
 //
 // Arguments:
 //   none
@@ -381,6 +695,9 @@ ELPipelineBuilder::rowSelected()
 // Creation:    August  7, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 15:02:37 EDT 2026
+//   Execute on a worker thread instead of blocking the GUI.
+//
 // ****************************************************************************
 void
 ELPipelineBuilder::executePipeline()
@@ -389,20 +706,255 @@ ELPipelineBuilder::executePipeline()
         return;
     Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
 
-    try {
-        pipeline->Execute();
+    if (executor->isRunning())
+        return;
+
+    SetExecuting(true);
+    executor->Start(pipeline);
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::executeDemanded
+//
+// Purpose:
+///   Slot for when the windows' demand changes, e.g. a plot now shows a
+///   pipeline which was dormant, or a hidden window came back.  Execute
+///   the first viewed pipeline which isn't showing its latest result;
+///   when that's done, we come back for the next (see executionFinished).
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::executeDemanded()
+{
+    demandPending = true;
+    if (executor->isRunning())
+        return;
+
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+    {
+        Pipeline *pipeline = Pipeline::allPipelines[i];
+        if (pipeline->NeedsExecute() && pipeline->GetName() != "(empty)")
+        {
+            SetExecuting(true);
+            executor->Start(pipeline);
+            return;
+        }
     }
-    catch (eavlException &e)
+    demandPending = false;
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::cancelExecution
+//
+// Purpose:
+///   Slot to stop a running execution.  Whatever every chunk finished
+///   is kept; the windows keep showing the previous output.  This
+///   returns right away; the pieces still executing finish in the
+///   background, and then executionFinished cleans up.  Anything
+///   waiting to execute after it is dropped.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:10:37 EDT 2026
+//   Don't block until the thread finishes.
+//
+// ****************************************************************************
+void
+ELPipelineBuilder::cancelExecution()
+{
+    progressBar->setFormat("Cancelling...");
+    scrubPending = false;
+    demandPending = false;
+    autoPending = false;
+    executor->Cancel();
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::executionProgress
+//
+// Purpose:
+///   Slot for progress reports from the execution thread.
+//
+// Arguments:
+//   done       pieces (chunk/stage pairs) completed
+//   total      pieces to complete
+//   what       the piece which just finished
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::executionProgress(int done, int total, const QString &what)
+{
+    if (!executor->isRunning() || executor->WasCancelled())
+        return;
+    progressBar->setRange(0, total);
+    progressBar->setValue(done);
+    progressBar->setFormat(what + " %p%");
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::executionFinished
+//
+// Purpose:
+///   Slot for when the execution thread is done.  If it succeeded,
+///   publish the new output and tell the watchers.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 17:45:50 EDT 2026
+//   Trim the result cache afterwards.
+//
+//   Jeremy Meredith, Sun Oct 18 19:10:26 EDT 2026
+//   Show the new profiling stats.
+//
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   Catch up with a slider that moved while we were executing.
+//
+//   Jeremy Meredith, Mon Oct 19 00:13:05 EDT 2026
+//   Mark the pipelines we pull from as executing too.
+//
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Publish each branch we brought up to date, even if a later one
+//   failed.
+//
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Only tell the watchers about pipelines we executed all the way, and
+//   go on to whatever else the windows are waiting for.
+//
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Catch up with edits made while we were executing.
+//
+//   Jeremy Meredith, Mon Oct 19 02:10:37 EDT 2026
+//   After a cancel, start the execution autoExecute is waiting on.
+//
+// ****************************************************************************
+void
+ELPipelineBuilder::executionFinished()
+{
+    // this may be a late notice from an execution we cancelled and
+    // then replaced with a new one
+    if (executor->isRunning())
+        return;
+
+    SetExecuting(false);
+    scrubbing = false;
+
+    Pipeline *pipeline = executor->GetPipeline();
+    if (!pipeline)
+        return;
+    std::vector<Pipeline*> pipes = executor->GetPipelines();
+    for (size_t i=0; i<pipes.size(); ++i)
+        pipes[i]->MarkExecuting(false);
+
+    // a cancel from the user dropped whatever was waiting (see
+    // cancelExecution), but autoExecute cancels to run newer settings
+    if (executor->WasCancelled())
+    {
+        scrubPending = false;
+        if (autoPending)
+            autoExecute();
+        if (demandPending)
+            executeDemanded();
+        return;
+    }
+
+    // a pipeline only executed as far as a branch needed has no new
+    // output to show
+    std::vector<Pipeline*> finished = executor->GetFinishedPipelines();
+    for (size_t i=0; i<finished.size(); ++i)
+    {
+        finished[i]->Publish();
+        if (finished[i]->HasResult(finished[i]->ops.size()))
+            emit pipelineUpdated(finished[i]);
+    }
+    if (!finished.empty())
     {
+        UpdatePipelineCombo();
+        if (currentPipeline >= 0 &&
+            pipeline == Pipeline::allPipelines[currentPipeline])
+        {
+            UpdateStatsDisplay();
+        }
+
+        // now that nobody's using the old output, we can let it go
+        Pipeline::TrimCache();
+    }
+
+    if (executor->GetError() != "")
+    {
+        scrubPending = false;
+        demandPending = false;
+        autoPending = false;
         QMessageBox::critical(this,
                               "Error executing pipeline",
-                              e.GetErrorText().c_str());
+                              executor->GetError().c_str());
         return;
     }
 
-    UpdatePipelineCombo();
+    // the box has the latest slider value, which the range would reset
+    if (scrubPending)
+        ApplyScrub();
+    else
+        UpdateScrubRange();
 
-    emit pipelineUpdated(pipeline);
+    if (autoPending)
+        autoExecute();
+    if (demandPending)
+        executeDemanded();
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::SetExecuting
+//
+// Purpose:
+///   Show the progress controls while executing, and don't let the user
+///   change the pipeline out from under the execution thread.
+//
+// Arguments:
+//   running    true if we're starting execution
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   Keep the sliders usable while executing for one of them.
+//
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Disable the branch button too.
+//
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Keep the operator settings usable when executing automatically,
+//   but never the source, which the execution reads.
+//
+// ****************************************************************************
+void
+ELPipelineBuilder::SetExecuting(bool running)
+{
+    progressBar->reset();
+    progressBar->setFormat("%p%");
+    progressBar->setVisible(running);
+    cancelButton->setVisible(running);
+    executeButton->setEnabled(!running);
+    addOpButton->setEnabled(!running);
+    deleteOpButton->setEnabled(!running);
+    branchButton->setEnabled(!running);
+    settingsGroup->setEnabled(!running || scrubbing ||
+                              autoExecuteBox->isChecked());
+    sourceSettings->setEnabled(!running);
+    if (scrubbing && scrubControl)
+        scrubControl->SetScrubbing(running);
 }
 
 // ****************************************************************************
@@ -418,6 +970,12 @@ ELPipelineBuilder::executePipeline()
 // Creation:    August 21, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 17:45:50 EDT 2026
+//   Let the result cache free what we no longer need.
+//
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Execute automatically if asked to.
+//
 // ****************************************************************************
 void
 ELPipelineBuilder::sourceUpdated()
@@ -428,8 +986,9 @@ ELPipelineBuilder::sourceUpdated()
     if (!pipeline || !pipeline->source)
         return;
 
-    // a bit brute force, but hopefully effective:
+    // a new source invalidates everything
     pipeline->ClearResults();
+    Pipeline::TrimCache();
 
     QTreeWidgetItem *sourceItem = tree->topLevelItem(0);
     sourceItem->setText(0, pipeline->source->GetSourceType().c_str());
@@ -437,6 +996,9 @@ ELPipelineBuilder::sourceUpdated()
 
     pipelineChooser->setItemText(currentPipeline,
                                  pipeline->GetName().c_str());
+
+    if (autoExecuteBox->isChecked())
+        autoExecuteTimer->start();
 }
 
 // ****************************************************************************
@@ -453,29 +1015,52 @@ ELPipelineBuilder::sourceUpdated()
 // Creation:    August 21, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 11:03:18 EDT 2026
+//   Only invalidate the results from this operator onward.
+//
+//   Jeremy Meredith, Mon Oct 19 02:04:15 EDT 2026
+//   Don't invalidate anything for a change which leaves the results
+//   alone (e.g. to a transform applied at render time); just redraw.
+//
+//   Jeremy Meredith, Mon Oct 19 02:33:48 EDT 2026
+//   Look in every pipeline; held edits may be applied after the user
+//   has moved on to another one.
+//
 // ****************************************************************************
 void
 ELPipelineBuilder::operatorUpdated(Attribute *settings)
 {
-    if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
-        return;
-    Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
-    
-    // a bit brute force, but hopefully effective:
-    pipeline->ClearResults();
-
     // find the operator with these settings; a bit of a hack
     // if we changed this to get info about which operator
     // these new settings came from, it would be cleaner
+    Pipeline *pipeline = NULL;
     int opindex = -1;
-    for (unsigned int i=0; i<pipeline->ops.size(); ++i)
+    for (size_t p=0; p<Pipeline::allPipelines.size() && opindex<0; ++p)
     {
-        if (pipeline->ops[i]->GetSettings() == settings)
+        pipeline = Pipeline::allPipelines[p];
+        for (unsigned int i=0; i<pipeline->ops.size(); ++i)
         {
-            opindex = i;
-            break;
+            if (pipeline->ops[i]->GetSettings() == settings)
+            {
+                opindex = i;
+                break;
+            }
         }
     }
+    if (opindex < 0)
+        return;
+
+    // only this operator and the ones after it need to re-execute,
+    // and only if the change affects the data
+    if (!pipeline->InvalidateChangedResults(opindex) &&
+        !pipeline->executing && !pipeline->output.empty())
+    {
+        emit pipelineUpdated(pipeline);
+    }
+
+    if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size() ||
+        pipeline != Pipeline::allPipelines[currentPipeline])
+        return;
 
     Operation *op = pipeline->ops[opindex];
 
@@ -485,17 +1070,290 @@ ELPipelineBuilder::operatorUpdated(Attribute *settings)
     item->setText(1, op->GetOperationInfo().c_str());
 }
 
+// ****************************************************************************
+// Method:  ELPipelineBuilder::operatorScrubbed
+//
+// Purpose:
+///   Slot for when an operator's slider moves.  We apply the settings
+///   and execute right away if we can; otherwise we'll apply wherever
+///   the slider is when the current execution finishes.  Only the
+///   operation and the ones after it re-execute (see operatorUpdated).
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::operatorScrubbed()
+{
+    ELScrubControl *controls = qobject_cast<ELScrubControl*>(sender());
+    if (!controls)
+        return;
+    scrubControl = controls;
+
+    if (executor->isRunning())
+    {
+        scrubPending = true;
+        return;
+    }
+    ApplyScrub();
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::ApplyScrub
+//
+// Purpose:
+///   Apply the settings from the slider's control and execute, leaving
+///   the sliders usable while we do.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::ApplyScrub()
+{
+    scrubPending = false;
+    if (!scrubControl)
+        return;
+
+    scrubControl->UpdateAttsFromWindow();
+    scrubbing = true;
+    executePipeline();
+    if (!executor->isRunning())
+        scrubbing = false;
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::operatorEdited
+//
+// Purpose:
+///   Slot for when the user edits an operator's settings.  When
+///   executing automatically, every edit restarts the timer, so a burst
+///   of them is applied and executed once (see autoExecute).
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::operatorEdited()
+{
+    if (!autoExecuteBox->isChecked())
+        return;
+    ELAttributeControl *controls = qobject_cast<ELAttributeControl*>(sender());
+    if (!controls)
+        return;
+
+    editedControls.insert(controls);
+    autoExecuteTimer->start();
+}
 
+// ****************************************************************************
+// Method:  ELPipelineBuilder::autoExecute
+//
+// Purpose:
+///   Apply the edits made since the last time and execute.  The newest
+///   settings supersede an execution of this pipeline still running
+///   with older ones, which we cancel; an execution of something
+///   unrelated is left to finish.  Either way, we don't wait; the edits
+///   stay pending, and we come back when the thread finishes (see
+///   executionFinished).
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:10:37 EDT 2026
+//   Don't block on a cancel; start the new execution once the old
+//   one has stopped.
+//
+//   Jeremy Meredith, Mon Oct 19 02:33:48 EDT 2026
+//   Apply edits held for other operators too, and execute whatever
+//   else they changed once this is done.
+//
+// ****************************************************************************
 void
-ELPipelineBuilder::deleteCurrentOp()
+ELPipelineBuilder::autoExecute()
 {
+    autoExecuteTimer->stop();
     if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
         return;
+    Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
+
+    if (executor->isRunning())
+    {
+        // whatever every chunk finished is kept, so the new execution
+        // picks up from there where the settings allow
+        if (pipeline->IsBusy())
+            executor->Cancel();
+        autoPending = true;
+        return;
+    }
+    autoPending = false;
+
+    // each of these invalidates the results from its operator on
+    // (see operatorUpdated), once for the whole burst of edits
+    HoldEdits();
+    std::map<QString, QWidget*>::iterator it;
+    for (it = opSettingsWidgets.begin(); it != opSettingsWidgets.end(); ++it)
+    {
+        ELAttributeControl *controls =
+            qobject_cast<ELAttributeControl*>(it->second);
+        if (controls)
+            controls->ApplyHeldEdits();
+    }
+    executePipeline();
+    executeDemanded();
+}
 
+// ****************************************************************************
+// Method:  ELPipelineBuilder::autoExecuteToggled
+//
+// Purpose:
+///   Slot for the auto-execute check box.  While it's on, the operator
+///   settings have no Apply buttons and stay usable while executing.
+//
+// Arguments:
+//   on         true to execute automatically
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:33:48 EDT 2026
+//   Drop held edits along with the ones waiting on the timer.
+//
+// ****************************************************************************
+void
+ELPipelineBuilder::autoExecuteToggled(bool on)
+{
+    std::map<QString, QWidget*>::iterator it;
+    for (it = opSettingsWidgets.begin(); it != opSettingsWidgets.end(); ++it)
+    {
+        ELAttributeControl *controls =
+            qobject_cast<ELAttributeControl*>(it->second);
+        if (controls)
+            controls->SetAutoApply(on);
+    }
+
+    if (!on)
+    {
+        autoExecuteTimer->stop();
+        editedControls.clear();
+        autoPending = false;
+        for (it = opSettingsWidgets.begin(); it != opSettingsWidgets.end(); ++it)
+        {
+            ELAttributeControl *controls =
+                qobject_cast<ELAttributeControl*>(it->second);
+            if (controls)
+                controls->DropHeldEdits();
+        }
+    }
+    if (executor->isRunning())
+        settingsGroup->setEnabled(on || scrubbing);
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::FlushAutoExecute
+//
+// Purpose:
+///   Before the settings widgets are switched to some other operator's
+///   settings, hold the edits made in them for the operators they were
+///   made for, and apply edits still waiting on the timer now.  While
+///   an execution runs, only applying them waits for it to finish.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:33:48 EDT 2026
+//   Hold the edits first, so they survive an execution in progress.
+//
+// ****************************************************************************
+void
+ELPipelineBuilder::FlushAutoExecute()
+{
+    HoldEdits();
+    if (autoExecuteTimer->isActive())
+        autoExecute();
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::HoldEdits
+//
+// Purpose:
+///   Have each settings widget edited since the last time hold its
+///   edits for the settings it's showing (see ELAttributeControl).
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::HoldEdits()
+{
+    std::set<ELAttributeControl*> edited;
+    edited.swap(editedControls);
+    for (std::set<ELAttributeControl*>::iterator it = edited.begin();
+         it != edited.end(); ++it)
+    {
+        (*it)->HoldEdits();
+    }
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::UpdateScrubRange
+//
+// Purpose:
+///   Set the range of the selected operator's sliders from the range
+///   of its field in the operator's input.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::UpdateScrubRange()
+{
+    if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
+        return;
     Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
 
-    // a bit brute force, but hopefully effective:
-    pipeline->ClearResults();
+    // the results belong to the execution thread until it finishes
+    if (executor->isRunning())
+        return;
+
+    QList<QTreeWidgetItem*> s = tree->selectedItems();
+    if (s.size() != 1)
+        return;
+    int opindex = tree->indexOfTopLevelItem(s[0]) - 1;
+    if (opindex < 0 || opindex >= (int)pipeline->ops.size())
+        return;
+
+    ELScrubControl *controls =
+        dynamic_cast<ELScrubControl*>(opSettingsWidgets[s[0]->text(0)]);
+    if (!controls)
+        return;
+
+    FieldStats range = pipeline->GetFieldStats(controls->GetRangeFieldName(),
+                                               opindex);
+    controls->SetRange(range.minval, range.maxval);
+}
+
+
+void
+ELPipelineBuilder::deleteCurrentOp()
+{
+    if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
+        return;
+
+    Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
 
     QList<QTreeWidgetItem*> s = tree->selectedItems();
     int n = s.size();
@@ -511,14 +1369,90 @@ ELPipelineBuilder::deleteCurrentOp()
     {
         QTreeWidgetItem *item = s[0];
         int rowindex = tree->indexOfTopLevelItem(item);
-        if (rowindex == 0)
+        if (rowindex <= 0)
             return;
         int opindex = rowindex - 1;
+        // the deleted operator's input is still good; it now
+        // feeds the operator which followed it
+        pipeline->InvalidateResults(opindex);
         for (int i = opindex; i < (int)pipeline->ops.size()-1; ++i)
             pipeline->ops[i] = pipeline->ops[i+1];
         pipeline->ops.resize(pipeline->ops.size()-1);
+
+        // branches from later stages move up with them, and one from
+        // the deleted operator's output now starts from its input
+        std::vector<Pipeline*> branches = pipeline->GetBranches();
+        for (size_t b=0; b<branches.size(); ++b)
+        {
+            int &stage = branches[b]->source->source_stage;
+            if (stage > opindex)
+                --stage;
+        }
         rebuildPipelineDisplay();
     }
 
     UpdatePipelineCombo();
 }
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::branchPipeline
+//
+// Purpose:
+///   Slot to start a new pipeline from the selected stage of the current
+///   one, and switch to editing it.  It shares everything up to that
+///   stage, which only executes once for both.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::branchPipeline()
+{
+    if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
+        return;
+    Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
+
+    QList<QTreeWidgetItem*> s = tree->selectedItems();
+    if (s.size() != 1)
+        return;
+    int stage = tree->indexOfTopLevelItem(s[0]);
+    if (stage < 0)
+        return;
+
+    pipeline->CreateBranch(stage);
+    pipelineChooser->addItem("");
+    pipelineChooser->setCurrentIndex(Pipeline::allPipelines.size()-1);
+    UpdatePipelineCombo();
+    activatePipeline(Pipeline::allPipelines.size()-1);
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::branchActivated
+//
+// Purpose:
+///   Slot for a double-click in the tree; if it's on a branch, switch
+///   to editing that branch.
+//
+// Arguments:
+//   item       the item double-clicked
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::branchActivated(QTreeWidgetItem *item)
+{
+    QVariant data = item->data(0, Qt::UserRole);
+    if (!data.isValid())
+        return;
+    int index = data.toInt();
+    if (index < 0 || index >= (int)Pipeline::allPipelines.size())
+        return;
+
+    pipelineChooser->setCurrentIndex(index);
+    activatePipeline(index);
+}
@@ -6,10 +6,17 @@
 #include "eavlImporter.h"
 #include "Pipeline.h"
 class ELSources;
+class ELAttributeControl;
+class ELScrubControl;
+class PipelineThread;
+class QCheckBox;
 class QGroupBox;
+class QTimer;
 class QTreeWidgetItem;
 class QTreeWidget;
 class QComboBox;
+class QProgressBar;
+class QPushButton;
 
 // ****************************************************************************
 // Class:  ELPipelineBuilder
@@ -22,6 +29,27 @@ class QComboBox;
 // Creation:    August  1, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 15:02:37 EDT 2026
+//   Execute in the background, with a progress bar and cancel button.
+//
+//   Jeremy Meredith, Sun Oct 18 19:10:26 EDT 2026
+//   Show profiling stats for each stage in the tree.
+//
+//   Jeremy Meredith, Sun Oct 18 20:05:44 EDT 2026
+//   Added SavePipeline.
+//
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   Added slider scrubbing for operator settings.
+//
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Show branches in the tree, and create them.
+//
+//   Jeremy Meredith, Mon Oct 19 00:58:06 EDT 2026
+//   Added the auto-execute mode.
+//
+//   Jeremy Meredith, Mon Oct 19 02:33:48 EDT 2026
+//   Added HoldEdits, so edits survive switching operators.
+//
 // ****************************************************************************
 class ELPipelineBuilder : public QWidget
 {
@@ -36,6 +64,7 @@ class ELPipelineBuilder : public QWidget
 
   public:
     ELPipelineBuilder(QWidget *parent);
+    virtual ~ELPipelineBuilder();
     void addSource(const std::string &fn, eavlImporter *imp);
     void addPipeline();
     void rebuildPipelineDisplay();
@@ -44,11 +73,22 @@ class ELPipelineBuilder : public QWidget
     void newOperation();
     void rowSelected();
     void executePipeline();
+    void executeDemanded();
+    void autoExecute();
+    void autoExecuteToggled(bool);
+    void cancelExecution();
+    void executionProgress(int done, int total, const QString &what);
+    void executionFinished();
     void activatePipeline(int);
     void sourceUpdated();
     void operatorUpdated(Attribute*);
+    void operatorScrubbed();
+    void operatorEdited();
     void deleteCurrentOp();
+    void branchPipeline();
+    void branchActivated(QTreeWidgetItem*);
     void NewPipeline();
+    void SavePipeline();
     void UpdatePipelineCombo();
 
   protected:
@@ -56,6 +96,31 @@ class ELPipelineBuilder : public QWidget
     QTreeWidget *tree;
     QGroupBox *settingsGroup;
     QComboBox *pipelineChooser;
+    QPushButton *addOpButton;
+    QPushButton *deleteOpButton;
+    QPushButton *branchButton;
+    QPushButton *executeButton;
+    QCheckBox *autoExecuteBox;
+    QPushButton *cancelButton;
+    QProgressBar *progressBar;
+    PipelineThread *executor;
+    ELScrubControl *scrubControl;
+    bool scrubbing;
+    bool scrubPending;
+    bool demandPending;
+    QTimer *autoExecuteTimer;
+    std::set<ELAttributeControl*> editedControls;
+    bool autoPending;
+
+    QWidget *GetSettingsWidget(const QString &name);
+    void SetExecuting(bool);
+    void UpdateStatsDisplay();
+    void AddBranchItems(Pipeline *pipeline,
+                        const std::vector<QTreeWidgetItem*> &stageItems);
+    void ApplyScrub();
+    void FlushAutoExecute();
+    void HoldEdits();
+    void UpdateScrubRange();
 };
 
 #endif
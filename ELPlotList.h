@@ -23,6 +23,12 @@
 // Creation:    January 10, 2013
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 21:52:30 EDT 2026
+//   Don't force plots to rebuild when their pipeline updates.
+//
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Say so when we add a plot ourselves; it changes what we view.
+//
 // ****************************************************************************
 class ELPlotList : public QWidget
 {
@@ -157,16 +163,12 @@ class ELPlotList : public QWidget
             plot.oneDimensional = oneDimensional; ///<\todo:hac!
             plot.pipe = pipe;
             plots.push_back(plot);
+            emit SomethingChanged();
         }
 
-        for (unsigned int i=0; i<plots.size(); i++)
-        {
-            Plot &p = plots[i];
-            if (p.pipe == pipe)
-            {
-                p.UpdateDataSet(pipe->results.back());
-            }
-        }
+        // plots whose pipeline has new output notice it themselves
+        // (see Plot::CreateEAVLPlot), and re-executing without changes
+        // leaves the output as it was, so nothing needs rebuilding
 
         UpdatePlotList();
         plotSettings->PipelineUpdated(pipe);
@@ -0,0 +1,243 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "ELScrubControl.h"
+
+#include <QSlider>
+
+/// Slider positions across the field's range.
+static const int scrubSteps = 1000;
+
+// ****************************************************************************
+// Constructor:  ELScrubControl::ELScrubControl
+//
+// Arguments:
+//   parent       the parent widget
+//   rangefield   the name of the setting holding the field name
+//   scrubfields  the names of the settings to give sliders
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+ELScrubControl::ELScrubControl(QWidget *parent, const std::string &rangefield,
+                               const std::vector<std::string> &scrubfields)
+    : ELAttributeControl(parent), rangeField(rangefield),
+      scrubFields(scrubfields), rangeMin(0), rangeMax(-1)
+{
+}
+
+// ****************************************************************************
+// Method:  ELScrubControl::GetFieldIndex
+//
+// Purpose:
+///   The index of a setting in the attributes, or -1.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+int
+ELScrubControl::GetFieldIndex(const std::string &name)
+{
+    if (!atts)
+        return -1;
+    for (int i=0; i<atts->GetNumFields(); i++)
+    {
+        if (atts->GetFieldName(i) == name)
+            return i;
+    }
+    return -1;
+}
+
+// ****************************************************************************
+// Method:  ELScrubControl::ConnectAttributes
+//
+// Purpose:
+///   Create the usual controls, then a slider under them for each
+///   of the settings we scrub.
+//
+// Arguments:
+//   a          the new Attribute to start watching
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELScrubControl::ConnectAttributes(Attribute *a)
+{
+    bool wascreated = created;
+    ELAttributeControl::ConnectAttributes(a);
+    if (wascreated || !atts || atts->GetNumFields() == 0)
+        return;
+
+    int row = atts->GetNumFields() + 1;
+    for (size_t i=0; i<scrubFields.size(); ++i)
+    {
+        QSlider *slider = new QSlider(Qt::Horizontal, this);
+        slider->setRange(0, scrubSteps);
+        slider->setEnabled(false);
+        layout->addWidget(new QLabel(scrubFields[i].c_str(), this), row, 0);
+        layout->addWidget(slider, row, 1);
+        connect(slider, SIGNAL(valueChanged(int)),
+                this, SLOT(SliderChanged()));
+        sliders.push_back(slider);
+        ++row;
+    }
+}
+
+// ****************************************************************************
+// Method:  ELScrubControl::GetRangeFieldName
+//
+// Purpose:
+///   The name of the field whose range the sliders span.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::string
+ELScrubControl::GetRangeFieldName()
+{
+    int index = GetFieldIndex(rangeField);
+    if (index < 0)
+        return "";
+    return atts->GetFieldAsString(index);
+}
+
+// ****************************************************************************
+// Method:  ELScrubControl::SetRange
+//
+// Purpose:
+///   Set the range the sliders span.  An empty range, e.g. when the
+///   operation's input hasn't been computed yet, disables them.
+//
+// Arguments:
+//   minval     the low end of the range
+//   maxval     the high end of the range
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELScrubControl::SetRange(double minval, double maxval)
+{
+    rangeMin = minval;
+    rangeMax = maxval;
+    for (size_t i=0; i<sliders.size(); ++i)
+        sliders[i]->setEnabled(rangeMax > rangeMin);
+    UpdateWindowFromAtts();
+}
+
+// ****************************************************************************
+// Method:  ELScrubControl::SetScrubbing
+//
+// Purpose:
+///   While the builder executes for a slider change, only the sliders
+///   may be used; the settings themselves mustn't change until the
+///   execution is done.
+//
+// Arguments:
+//   scrubbing  true while executing for a slider change
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELScrubControl::SetScrubbing(bool scrubbing)
+{
+    for (size_t i=0; i<lineEdits.size(); ++i)
+    {
+        if (lineEdits[i])
+            lineEdits[i]->setReadOnly(scrubbing);
+        if (checkBoxes[i])
+            checkBoxes[i]->setEnabled(!scrubbing);
+    }
+    if (!sliders.empty())
+        applyButton->setEnabled(!scrubbing);
+}
+
+// ****************************************************************************
+// Method:  ELScrubControl::UpdateWindowFromAtts
+//
+// Purpose:
+///   Update the usual controls, and move the sliders to match.  A
+///   slider for an empty list of values is disabled.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:53:21 EDT 2026
+//   Don't read the value of an empty list.
+//
+// ****************************************************************************
+void
+ELScrubControl::UpdateWindowFromAtts()
+{
+    ELAttributeControl::UpdateWindowFromAtts();
+    if (!(rangeMax > rangeMin))
+        return;
+
+    for (size_t i=0; i<sliders.size(); ++i)
+    {
+        int index = GetFieldIndex(scrubFields[i]);
+        if (index < 0)
+            continue;
+        bool hasValue = atts->GetFieldLength(index) > 0;
+        sliders[i]->setEnabled(hasValue);
+        if (!hasValue)
+            continue;
+        double v = atts->GetFieldAsDouble(index);
+        int pos = int(0.5 + scrubSteps * (v - rangeMin) / (rangeMax - rangeMin));
+        sliders[i]->blockSignals(true);
+        sliders[i]->setValue(std::max(0, std::min(scrubSteps, pos)));
+        sliders[i]->blockSignals(false);
+    }
+}
+
+// ****************************************************************************
+// Method:  ELScrubControl::SliderChanged
+//
+// Purpose:
+///   Put the value for a moved slider in its setting's box, and let the
+///   builder know.  (It applies the settings when it's ready.)
+///   For a list of values, the slider moves the first one.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:31:47 EDT 2026
+//   Keep the rest of a list of values.
+//
+// ****************************************************************************
+void
+ELScrubControl::SliderChanged()
+{
+    QSlider *slider = qobject_cast<QSlider*>(sender());
+    for (size_t i=0; i<sliders.size(); ++i)
+    {
+        if (sliders[i] != slider)
+            continue;
+        int index = GetFieldIndex(scrubFields[i]);
+        if (index < 0 || !lineEdits[index])
+            continue;
+        double v = rangeMin + (rangeMax - rangeMin) *
+                              double(slider->value()) / double(scrubSteps);
+        QStringList sl = lineEdits[index]->text().split(QRegExp("[, \t]"),
+                                                        QString::SkipEmptyParts);
+        if (sl.empty())
+            sl.push_back("");
+        sl[0] = QString().setNum(v);
+        lineEdits[index]->setText(sl.join("  "));
+    }
+    emit scrubbed();
+}
@@ -0,0 +1,52 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EL_SCRUB_CONTROL_H
+#define EL_SCRUB_CONTROL_H
+
+#include "ELAttributeControl.h"
+
+class QSlider;
+
+// ****************************************************************************
+// Class:  ELScrubControl
+//
+// Purpose:
+///   Attribute controls with a slider for some of the numeric settings,
+///   spanning the range of the field named by another setting (e.g. an
+///   isovalue over the range of the isosurface's field).  Dragging a
+///   slider changes the text in the setting's box and emits scrubbed();
+///   the pipeline builder then applies the settings and re-executes,
+///   catching up with the slider whenever an execution finishes.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+class ELScrubControl : public ELAttributeControl
+{
+    Q_OBJECT
+  protected:
+    std::string               rangeField;
+    std::vector<std::string>  scrubFields;
+    std::vector<QSlider*>     sliders;
+    double                    rangeMin;
+    double                    rangeMax;
+
+  public:
+    ELScrubControl(QWidget *parent, const std::string &rangefield,
+                   const std::vector<std::string> &scrubfields);
+    virtual void ConnectAttributes(Attribute *a);
+    std::string  GetRangeFieldName();
+    void         SetRange(double minval, double maxval);
+    void         SetScrubbing(bool);
+  public slots:
+    virtual void UpdateWindowFromAtts();
+  protected slots:
+    void SliderChanged();
+  signals:
+    void scrubbed();
+  protected:
+    int GetFieldIndex(const std::string &name);
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include <QGridLayout>
 #include <QComboBox>
 
+#include "ELAttributeControl.h"
 #include "Pipeline.h"
 
 // ****************************************************************************
@@ -16,6 +17,12 @@
 // Creation:    August  2, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:13:05 EDT 2026
+//   Added the pipeline source controls.
+//
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Added the geometry source controls.
+//
 // ****************************************************************************
 ELSources::ELSources(QWidget *parent)
     : QTabWidget(parent)
@@ -45,12 +52,33 @@ ELSources::ELSources(QWidget *parent)
     // Pipeline source
     //
     QWidget *pipeTab = new QWidget();
+    QGridLayout *pipeLayout = new QGridLayout(pipeTab);
+
+    pipeCombo = new QComboBox(pipeTab);
+    pipeLayout->addWidget(pipeCombo, 0, 0);
+    stageCombo = new QComboBox(pipeTab);
+    pipeLayout->addWidget(stageCombo, 1, 0);
+
+    connect(pipeCombo, SIGNAL(currentIndexChanged(int)),
+            this, SLOT(pipeChanged(int)));
+    connect(stageCombo, SIGNAL(currentIndexChanged(int)),
+            this, SLOT(stageChanged(int)));
+
     addTab(pipeTab, "Pipeline");
 
     //
     // Geometry source
     //
     QWidget *geomTab = new QWidget();
+    QGridLayout *geomLayout = new QGridLayout(geomTab);
+
+    geomControl = new ELAttributeControl(geomTab);
+    geomLayout->addWidget(geomControl, 0, 0);
+    geomLayout->setRowStretch(1, 1);
+
+    connect(geomControl, SIGNAL(settingsChanged(Attribute*)),
+            this, SLOT(geometryChanged(Attribute*)));
+
     addTab(geomTab, "Geometry");
 }
 
@@ -135,6 +163,9 @@ ELSources::fileMeshChanged(int index)
 // Creation:    August 21, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:13:05 EDT 2026
+//   Added the pipeline source controls.
+//
 // ****************************************************************************
 void
 ELSources::tabChanged(int index)
@@ -143,9 +174,138 @@ ELSources::tabChanged(int index)
         return;
 
     source->sourcetype = Source::SourceType(index);
+    if (source->sourcetype == Source::Pipe)
+        UpdatePipeCombos();
+    emit sourceChanged();
+}
+
+// ****************************************************************************
+// Method:  ELSources::pipeChanged
+//
+// Purpose:
+///   Slot for when the source pipeline combo box active item changes.
+///   We start from its final result until the user picks a stage.
+//
+// Arguments:
+//   index      the new index in the combo
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELSources::pipeChanged(int index)
+{
+    if (!source || index < 0)
+        return;
+
+    int p = pipeCombo->itemData(index).toInt();
+    source->source_pipe = (p < 0) ? NULL : Pipeline::allPipelines[p];
+    source->source_stage = -1;
+    UpdatePipeCombos();
     emit sourceChanged();
 }
 
+// ****************************************************************************
+// Method:  ELSources::stageChanged
+//
+// Purpose:
+///   Slot for when the source pipeline stage combo box active item changes.
+//
+// Arguments:
+//   index      the new index in the combo
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELSources::stageChanged(int index)
+{
+    if (!source || index < 0)
+        return;
+
+    source->source_stage = stageCombo->itemData(index).toInt();
+    emit sourceChanged();
+}
+
+// ****************************************************************************
+// Method:  ELSources::geometryChanged
+//
+// Purpose:
+///   Slot for when the geometry settings were applied.  They're the
+///   source's own settings, so they've already changed.
+//
+// Arguments:
+//   atts       the geometry settings
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELSources::geometryChanged(Attribute *)
+{
+    if (!source)
+        return;
+    emit sourceChanged();
+}
+
+// ****************************************************************************
+// Method:  ELSources::UpdatePipeCombos
+//
+// Purpose:
+///   Refill the pipeline source combo boxes.  We leave out any pipeline
+///   which takes its input from this one, since that would be a loop.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELSources::UpdatePipeCombos()
+{
+    Pipeline *owner = NULL;
+    for (unsigned int i=0; i<Pipeline::allPipelines.size(); i++)
+    {
+        if (Pipeline::allPipelines[i]->source == source)
+            owner = Pipeline::allPipelines[i];
+    }
+
+    pipeCombo->blockSignals(true);
+    pipeCombo->clear();
+    pipeCombo->addItem("(none)", -1);
+    for (unsigned int i=0; i<Pipeline::allPipelines.size(); i++)
+    {
+        Pipeline *p = Pipeline::allPipelines[i];
+        if (owner && p->DependsOn(owner))
+            continue;
+        pipeCombo->addItem(p->GetName().c_str(), int(i));
+        if (p == source->source_pipe)
+            pipeCombo->setCurrentIndex(pipeCombo->count()-1);
+    }
+    pipeCombo->blockSignals(false);
+
+    stageCombo->blockSignals(true);
+    stageCombo->clear();
+    stageCombo->addItem("Final result", -1);
+    if (source->source_pipe)
+    {
+        Pipeline *p = source->source_pipe;
+        stageCombo->addItem("Read", 0);
+        for (unsigned int i=0; i<p->ops.size(); i++)
+            stageCombo->addItem(p->ops[i]->GetOperationName().c_str(),
+                                int(i+1));
+    }
+    int stageindex = stageCombo->findData(source->source_stage);
+    stageCombo->setCurrentIndex(stageindex < 0 ? 0 : stageindex);
+    stageCombo->blockSignals(false);
+}
+
 // ****************************************************************************
 // Method:  ELSources::ConnectSettings
 //
@@ -159,11 +319,15 @@ ELSources::tabChanged(int index)
 // Creation:    August 21, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Added the geometry source controls.
+//
 // ****************************************************************************
 void
 ELSources::ConnectSettings(Source *s)
 {
     source = s;
+    geomControl->ConnectAttributes(s->geometry);
 }
 
 // ****************************************************************************
@@ -179,6 +343,12 @@ ELSources::ConnectSettings(Source *s)
 // Creation:    August 21, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:13:05 EDT 2026
+//   Added the pipeline source controls.
+//
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Added the geometry source controls.
+//
 // ****************************************************************************
 void
 ELSources::UpdateWindowFromSettings()
@@ -203,4 +373,10 @@ ELSources::UpdateWindowFromSettings()
     combo->blockSignals(true);
     combo->setCurrentIndex(sourceindex);
     combo->blockSignals(false);
+
+    // pipeline tab
+    UpdatePipeCombos();
+
+    // geometry tab
+    geomControl->UpdateWindowFromAtts();
 }
@@ -8,6 +8,8 @@
 
 class QComboBox;
 class QTreeWidget;
+class Attribute;
+class ELAttributeControl;
 class QTreeWidgetItem;
 class Source;
 
@@ -21,6 +23,12 @@ class Source;
 // Creation:    August  2, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:13:05 EDT 2026
+//   Added the pipeline source controls.
+//
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Added the geometry source controls.
+//
 // ****************************************************************************
 class ELSources : public QTabWidget
 {
@@ -35,6 +43,9 @@ class ELSources : public QTabWidget
     };
 
     QComboBox *combo;
+    QComboBox *pipeCombo;
+    QComboBox *stageCombo;
+    ELAttributeControl *geomControl;
     Source *source;
 
   public:
@@ -44,9 +55,15 @@ class ELSources : public QTabWidget
     void ConnectSettings(Source *s);
     void UpdateWindowFromSettings();
 
+  protected:
+    void UpdatePipeCombos();
+
   public slots:
     void fileMeshChanged(int);
     void tabChanged(int);
+    void pipeChanged(int);
+    void stageChanged(int);
+    void geometryChanged(Attribute*);
 
   signals:
     void sourceChanged();
@@ -25,6 +25,9 @@
 // Creation:    March 12, 2013
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 21:52:30 EDT 2026
+//   Don't force the plot to rebuild when the variable changes.
+//
 // ****************************************************************************
 class ELSurfacePlotSettings : public QWidget
 {
@@ -211,6 +214,16 @@ class ELSurfacePlotSettings : public QWidget
             if (plot->cellset == "" && plot->field == dsinfo.nodalfields[i].name)
                 selItem = fItem;
         }
+        for (unsigned int i=0; i<dsinfo.unloadedfields.size(); ++i)
+        {
+            QTreeWidgetItem *fItem = new QTreeWidgetItem(QStringList()
+                                                         <<dsinfo.unloadedfields[i].c_str()
+                                                         <<"(not loaded)");
+            ptsItem->addChild(fItem);
+            fieldList[fieldList.size()-1].push_back(dsinfo.unloadedfields[i]);
+            if (plot->cellset == "" && plot->field == dsinfo.unloadedfields[i])
+                selItem = fItem;
+        }
         ptsItem->setExpanded(true);
 
 
@@ -245,6 +258,16 @@ class ELSurfacePlotSettings : public QWidget
                 if (plot->cellset == csname && plot->field == dsinfo.cellsetfields[csname][i].name)
                     selItem = fItem;
             }
+            for (unsigned int i=0; i<dsinfo.unloadedfields.size(); ++i)
+            {
+                QTreeWidgetItem *fItem = new QTreeWidgetItem(QStringList()
+                                                             <<dsinfo.unloadedfields[i].c_str()
+                                                             <<"(not loaded)");
+                csItem->addChild(fItem);
+                fieldList[fieldList.size()-1].push_back(dsinfo.unloadedfields[i]);
+                if (plot->cellset == csname && plot->field == dsinfo.unloadedfields[i])
+                    selItem = fItem;
+            }
             csItem->setExpanded(true);
         }
 
@@ -393,9 +416,7 @@ class ELSurfacePlotSettings : public QWidget
             return;
 
         // here, we set the field index and cell index given a field name
-
-        // need to force an update when the sel
-        plot->UpdateDataSet(plot->pipe->results.back());
+        // (the plot rebuilds whatever that changes when it's next drawn)
 
         string oldCS = plot->cellset;
         string oldF = plot->field;
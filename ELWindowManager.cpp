@@ -2,6 +2,7 @@
 #include "ELWindowManager.h"
 
 #include "STL.h"
+#include "Pipeline.h"
 
 #include <QFileInfo>
 #include <QTreeWidget>
@@ -350,6 +351,12 @@ ELWindowManager::ELWindowManager(QWidget *parent)
 // Creation:    August  3, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Windows we hide no longer count as viewing their pipelines.
+//
+//   Jeremy Meredith, Mon Oct 19 03:02:37 EDT 2026
+//   Windows we show get the pipeline updates they missed.
+//
 // ****************************************************************************
 void
 ELWindowManager::SetArrangement(const std::string &name)
@@ -393,6 +400,15 @@ ELWindowManager::SetArrangement(const std::string &name)
         windowLayout->addWidget(windowframes[i],
                                 a.y[i],a.x[i], a.h[i],a.w[i]);
         windowframes[i]->show();
+
+        // catch up on what happened while it was hidden
+        for (std::set<Pipeline*>::iterator it = missedUpdates[i].begin();
+             it != missedUpdates[i].end(); ++it)
+        {
+            QMetaObject::invokeMethod(windowframes[i]->GetWindow(),
+                                      "PipelineUpdated", Q_ARG(Pipeline*, *it));
+        }
+        missedUpdates[i].clear();
     }
 
     // set spacing
@@ -414,6 +430,8 @@ ELWindowManager::SetArrangement(const std::string &name)
     for (int i=maxcol+1; i<windowLayout->columnCount(); i++)
         windowLayout->setColumnStretch(i, 0);
     windowLayout->invalidate();
+
+    UpdateDemand();
 }
 
 // ****************************************************************************
@@ -553,6 +571,12 @@ ELWindowManager::GetWindow(int index)
 // Creation:    August  20, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Watch the new window's plots for what it needs executed.
+//
+//   Jeremy Meredith, Mon Oct 19 03:02:37 EDT 2026
+//   A new window has no updates to catch up on.
+//
 // ****************************************************************************
 void
 ELWindowManager::ChangeWindowType(int index, const QString &type)
@@ -608,9 +632,116 @@ ELWindowManager::ChangeWindowType(int index, const QString &type)
     {
         cerr << "sorry, didn't implement window type "<<type.toStdString()<<" yet\n";
     }
+    missedUpdates[index].clear();
+    if (settings[index])
+    {
+        connect(settings[index], SIGNAL(SomethingChanged()),
+                this, SLOT(UpdateDemand()), Qt::UniqueConnection);
+    }
+    UpdateDemand();
     ///\todo: hack to set the combo box when called from a client
     /// instead o as a signal from the frame itself
     if (!sender())
         windowframes[index]->WindowTypeChanged(type);
 }
 
+// ****************************************************************************
+// Method:  ELWindowManager::UpdateDemand
+//
+// Purpose:
+///   Mark the pipelines shown by the windows in the current arrangement
+///   as viewed, and everything else as not.  Windows hidden by the
+///   arrangement don't count.  The plots' variables are what their
+///   pipelines are asked for (see Pipeline::UpdateRequestedVariables),
+///   and one may not have been read.  If that changed anything, we tell
+///   whoever executes pipelines (see Pipeline::GetDemandedStage).
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:26:44 EDT 2026
+//   Request the plots' variables here, rather than having the plots
+//   execute their pipelines themselves while drawing.  A busy pipeline
+//   gets asked again when it's done (see ELMainWindow).
+//
+//   Jeremy Meredith, Mon Oct 19 02:26:14 EDT 2026
+//   Rebuild the requested variables each time, so ones nobody plots
+//   any more are dropped.
+//
+// ****************************************************************************
+void
+ELWindowManager::UpdateDemand()
+{
+    std::set<Pipeline*> viewed;
+    std::map<Pipeline*, std::set<std::string> > plotted;
+    int n = (arrangementIndex < 0) ? 0 : arrangements[arrangementIndex].n;
+    for (int i=0; i<n; i++)
+    {
+        ELPlotList *plotlist = qobject_cast<ELPlotList*>(settings[i]);
+        if (plotlist)
+        {
+            for (size_t j=0; j<plotlist->plots.size(); j++)
+            {
+                Pipeline *pipe = plotlist->plots[j].pipe;
+                if (!pipe)
+                    continue;
+                viewed.insert(pipe);
+                plotted[pipe].insert(plotlist->plots[j].field);
+            }
+        }
+        ELPipelineChooser *chooser = qobject_cast<ELPipelineChooser*>(settings[i]);
+        if (chooser && chooser->GetPipeline())
+            viewed.insert(chooser->GetPipeline());
+    }
+
+    bool requested = Pipeline::UpdateRequestedVariables(plotted);
+    bool changed = false;
+    for (size_t i=0; i<Pipeline::allPipelines.size(); i++)
+    {
+        Pipeline *p = Pipeline::allPipelines[i];
+        bool v = viewed.count(p) > 0;
+        if (p->viewed != v)
+        {
+            p->viewed = v;
+            changed = true;
+        }
+    }
+    if (changed || requested)
+        emit DemandChanged();
+}
+
+// ****************************************************************************
+// Method:  ELWindowManager::PipelineUpdated
+//
+// Purpose:
+///   Tell the windows in the current arrangement that a pipeline changed.
+///   A window the arrangement hides would only remake plots nobody sees,
+///   so we hold on to the update and pass it along when SetArrangement
+///   shows the window again.
+//
+// Arguments:
+//   pipe       the pipeline that was updated
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELWindowManager::PipelineUpdated(Pipeline *pipe)
+{
+    int n = (arrangementIndex < 0) ? 0 : arrangements[arrangementIndex].n;
+    for (int i=0; i<MAX_WINDOWS; i++)
+    {
+        if (!windowframes[i])
+            continue;
+        if (i >= n)
+        {
+            missedUpdates[i].insert(pipe);
+            continue;
+        }
+        QMetaObject::invokeMethod(windowframes[i]->GetWindow(),
+                                  "PipelineUpdated", Q_ARG(Pipeline*, pipe));
+    }
+}
@@ -12,12 +12,21 @@
 // Class:  ELWindowManager
 //
 // Purpose:
-///   Contains a layout of ELWindows.
+///   Contains a layout of ELWindows.  It also keeps track of which
+///   pipelines the visible windows show (see UpdateDemand), so that
+///   only those are executed.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    August  3, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Added UpdateDemand and the DemandChanged signal.
+//
+//   Jeremy Meredith, Mon Oct 19 03:02:37 EDT 2026
+//   Pass pipeline updates on to the windows here, so the ones the
+//   arrangement hides can catch up when they're shown (see PipelineUpdated).
+//
 // ****************************************************************************
 class ELWindowManager : public QWidget
 {
@@ -27,6 +36,7 @@ class ELWindowManager : public QWidget
 
     ELWindowFrame *windowframes[MAX_WINDOWS];
     QWidget *settings[MAX_WINDOWS];
+    std::set<Pipeline*> missedUpdates[MAX_WINDOWS];
     int arrangementIndex;
 
     QGridLayout *windowLayout;
@@ -35,6 +45,7 @@ class ELWindowManager : public QWidget
   signals:
     void WindowAdded(QWidget*);
     void SettingsActivated(QWidget*);
+    void DemandChanged();
 
   public:
     ELWindowManager(QWidget *parent);
@@ -46,6 +57,8 @@ class ELWindowManager : public QWidget
   public slots:
     void arrangementChosen();
     void ChangeWindowType(int, const QString &);
+    void UpdateDemand();
+    void PipelineUpdated(Pipeline *);
 };
 
 #endif
@@ -26,13 +26,11 @@ class ElevateAttributes : public Attribute
 class ElevateOperation : public Operation
 {
     ElevateAttributes  *atts;
-    eavlElevateMutator *mutator;
   public:
     ElevateOperation()
         : Operation()
     {
         atts = new ElevateAttributes;
-        mutator = new eavlElevateMutator;
     }
     virtual std::string GetOperationName()
     {
@@ -50,6 +48,13 @@ class ElevateOperation : public Operation
     {
         return atts;
     }
+    virtual DataSetParts GetModifiedParts(eavlDataSet *)
+    {
+        // the elevated axis goes into the existing coordinate system
+        DataSetParts parts;
+        parts.coordinateSystems.push_back(0);
+        return parts;
+    }
     virtual std::vector<std::string> GetNeededVariables()
     {
         std::vector<std::string> vars;
@@ -61,12 +66,14 @@ class ElevateOperation : public Operation
     {
         return std::vector<std::string>();
     }
-    virtual void Execute()
+    virtual eavlDataSet *Execute(eavlDataSet *input)
     {
-        mutator->SetDataSet(input);
-        mutator->SetField(atts->field);
-        mutator->Execute();
-        output = input;
+        eavlElevateMutator mutator;
+        mutator.SetDataSet(input);
+        mutator.SetField(atts->field);
+        QMutexLocker lock(&eavlExecutorMutex);
+        mutator.Execute();
+        return input;
     }
 };
 
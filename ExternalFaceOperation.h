@@ -3,6 +3,7 @@
 #define OP_EXTERNAL_FACE_H
 
 #include "Operation.h"
+#include "ExternalFaces.h"
 
 #include <eavlExternalFaceMutator.h>
 
@@ -18,16 +19,19 @@
 // Creation:    August 9, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 23:16:40 EDT 2026
+//   Use the parallel face matching in ExternalFaceCache, which also lets
+//   results with the same cell set share their faces.  Cell shapes it
+//   doesn't handle still go to the EAVL mutator.
+//
 // ****************************************************************************
 class ExternalFaceOperation : public Operation
 {
-    eavlExternalFaceMutator *mutator;
   public:
   //  Is
     ExternalFaceOperation()
         : Operation()
     {
-        mutator = new eavlExternalFaceMutator;
     }
     virtual std::string GetOperationName()
     {
@@ -45,13 +49,24 @@ class ExternalFaceOperation : public Operation
     {
         return NULL;
     }
-    virtual void Execute()
+    virtual eavlDataSet *Execute(eavlDataSet *input)
     {
-        mutator->SetDataSet(input);
         ///\todo: assuming last cell set
-        mutator->SetCellSet(input->GetCellSet(input->GetNumCellSets()-1)->GetName());
-        mutator->Execute();
-        output = input;
+        eavlCellSet *cs = input->GetCellSet(input->GetNumCellSets()-1);
+
+        eavlCellSet *faces = ExternalFaceCache::Get(cs);
+        if (faces)
+        {
+            input->AddCellSet(faces);
+            return input;
+        }
+
+        eavlExternalFaceMutator mutator;
+        mutator.SetDataSet(input);
+        mutator.SetCellSet(cs->GetName());
+        QMutexLocker lock(&eavlExecutorMutex);
+        mutator.Execute();
+        return input;
     }
 };
 
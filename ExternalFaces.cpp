@@ -0,0 +1,145 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "ExternalFaces.h"
+#include "Topology.h"
+
+#include <eavlCellSetExplicit.h>
+
+#include <QMutexLocker>
+
+QMutex                                          ExternalFaceCache::lock;
+std::map<eavlCellSet*,ExternalFaceCache::Entry> ExternalFaceCache::entries;
+
+// ****************************************************************************
+// Method:  ExternalFaceCache::Compute
+//
+// Purpose:
+///   Find the external faces of a cell set (or the boundary edges of a
+///   2D one) as a new explicit cell set named "extface_of_" plus its
+///   name.  Returns NULL if it has cells of a shape we don't handle.
+//
+// Arguments:
+//   cs         the cell set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 23:34:12 EDT 2026
+//   Take the faces from the shared TopologyCache.
+//
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   Release the topology when we're done with it.
+//
+// ****************************************************************************
+eavlCellSet *
+ExternalFaceCache::Compute(eavlCellSet *cs)
+{
+    int dim = cs->GetDimensionality();
+    if (dim < 2)
+        return NULL;
+
+    const CellSetTopology *topo = TopologyCache::GetFaces(cs);
+    if (!topo)
+        return NULL;
+
+    eavlExplicitConnectivity conn;
+    int nfaces = topo->GetNumFaces();
+    for (int f=0; f<nfaces; ++f)
+    {
+        if (topo->faceCells[2*f+1] >= 0)
+            continue;
+        int n = 0, nodes[4];
+        while (n < 4 && topo->faceNodes[4*f+n] >= 0)
+        {
+            nodes[n] = topo->faceNodes[4*f+n];
+            ++n;
+        }
+        eavlCellShape shape = (n == 2) ? EAVL_BEAM :
+                              (n == 3) ? EAVL_TRI : EAVL_QUAD;
+        conn.AddElement(shape, n, nodes);
+    }
+    TopologyCache::Release(topo);
+
+    eavlCellSetExplicit *out =
+        new eavlCellSetExplicit(string("extface_of_") + cs->GetName(), dim-1);
+    out->SetCellNodeConnectivity(conn);
+    return out;
+}
+
+// ****************************************************************************
+// Method:  ExternalFaceCache::Get
+//
+// Purpose:
+///   Get the external faces of a cell set, computing them if we haven't
+///   yet.  Returns NULL if we can't (see Compute).  Two threads asking
+///   for the same new cell set at once may both compute it; one of the
+///   results is thrown away.
+//
+// Arguments:
+//   cs         the cell set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   Never replace an entry; the old face set may be in use.  We're
+//   told to forget a cell set before its address can be reused.
+//
+// ****************************************************************************
+eavlCellSet *
+ExternalFaceCache::Get(eavlCellSet *cs)
+{
+    {
+        QMutexLocker locker(&lock);
+        std::map<eavlCellSet*,Entry>::iterator it = entries.find(cs);
+        if (it != entries.end())
+            return it->second.faces;
+    }
+
+    // don't hold the lock while we compute
+    eavlCellSet *faces = Compute(cs);
+    if (!faces)
+        return NULL;
+
+    QMutexLocker locker(&lock);
+    std::map<eavlCellSet*,Entry>::iterator it = entries.find(cs);
+    if (it != entries.end())
+    {
+        delete faces;
+        return it->second.faces;
+    }
+    Entry &entry = entries[cs];
+    entry.faces = faces;
+    return faces;
+}
+
+// ****************************************************************************
+// Method:  ExternalFaceCache::Forget
+//
+// Purpose:
+///   Forget a cell set which is about to be freed, whether it's one we
+///   found the faces of or one of the face cell sets.  (The ResultCache
+///   owns the face cell sets once they're in a result.)
+//
+// Arguments:
+//   part       the cell set (or an array, which we ignore)
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ExternalFaceCache::Forget(void *part)
+{
+    QMutexLocker locker(&lock);
+    std::map<eavlCellSet*,Entry>::iterator it = entries.begin();
+    while (it != entries.end())
+    {
+        if ((void*)it->first == part || (void*)it->second.faces == part)
+            entries.erase(it++);
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EXTERNAL_FACES_H
+#define EXTERNAL_FACES_H
+
+#include "STL.h"
+#include "eavlCellSet.h"
+#include <QMutex>
+
+// ****************************************************************************
+// Class:  ExternalFaceCache
+//
+// Purpose:
+///   Finds the external faces of a cell set (the faces which belong to
+///   only one cell) and remembers them.  The faces only depend on the
+///   connectivity, and a cell set shared between pipeline results never
+///   changes (see CreateCopyOnWriteInput), so results which differ only
+///   in their fields can share one face cell set.  When the ResultCache
+///   frees either cell set, it tells us to forget it.
+///
+///   The faces come from the TopologyCache's face table; the external
+///   ones are those with no second cell.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 23:34:12 EDT 2026
+//   Use the shared face table instead of matching faces ourselves.
+//
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   Dropped the size check for a reused address.
+//
+// ****************************************************************************
+class ExternalFaceCache
+{
+  protected:
+    struct Entry
+    {
+        eavlCellSet *faces;
+    };
+    static QMutex                        lock;
+    static std::map<eavlCellSet*,Entry>  entries;
+
+  public:
+    static eavlCellSet *Get(eavlCellSet *cs);
+    static void         Forget(void *part);
+
+    static eavlCellSet *Compute(eavlCellSet *cs);
+};
+
+#endif
@@ -0,0 +1,240 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "FieldStats.h"
+
+#include <QMutexLocker>
+#include <QtConcurrentMap>
+
+#include <cfloat>
+#include <cmath>
+
+QMutex                           FieldStatsCache::lock;
+std::map<eavlArray*,FieldStats>  FieldStatsCache::stats;
+
+/// Tuples per piece of work; small arrays are done in one piece.
+static const int statsBlockSize = 1 << 16;
+
+// ****************************************************************************
+// Constructor:  FieldStats::FieldStats
+//
+// Purpose:
+///   Start out empty, so anything merged in replaces these.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+FieldStats::FieldStats()
+    : minval(DBL_MAX), maxval(-DBL_MAX), minpos(DBL_MAX),
+      minmag(DBL_MAX), maxmag(-DBL_MAX)
+{
+}
+
+void
+FieldStats::Merge(const FieldStats &s)
+{
+    minval = std::min(minval, s.minval);
+    maxval = std::max(maxval, s.maxval);
+    minpos = std::min(minpos, s.minpos);
+    minmag = std::min(minmag, s.minmag);
+    maxmag = std::max(maxmag, s.maxmag);
+}
+
+// ****************************************************************************
+// Function:  AccumulateStats
+//
+// Purpose:
+///   Add a range of tuples of a plain array of values to some stats.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+template <class T>
+static void
+AccumulateStats(const T *vals, int ncomp, int begin, int end, FieldStats &s)
+{
+    for (int i=begin; i<end; ++i)
+    {
+        double mag2 = 0;
+        for (int c=0; c<ncomp; ++c)
+        {
+            double v = vals[long(i)*ncomp + c];
+            if (v < s.minval)
+                s.minval = v;
+            if (v > s.maxval)
+                s.maxval = v;
+            if (v > 0 && v < s.minpos)
+                s.minpos = v;
+            mag2 += v*v;
+        }
+        double mag = sqrt(mag2);
+        if (mag < s.minmag)
+            s.minmag = mag;
+        if (mag > s.maxmag)
+            s.maxmag = mag;
+    }
+}
+
+// ****************************************************************************
+// Struct:  BlockStats
+//
+// Purpose:
+///   Function object for QtConcurrent computing the stats of one block
+///   of tuples in a single pass.  We read the values directly for the
+///   array types we know, since a virtual call per value costs more
+///   than the comparisons.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct BlockStats
+{
+    typedef FieldStats result_type;
+
+    eavlArray *arr;
+    const void *vals;
+
+    FieldStats operator()(int block)
+    {
+        int ncomp = arr->GetNumberOfComponents();
+        int begin = block * statsBlockSize;
+        int end = std::min(begin + statsBlockSize, arr->GetNumberOfTuples());
+
+        FieldStats s;
+        if (dynamic_cast<eavlFloatArray*>(arr))
+            AccumulateStats((const float*)vals, ncomp, begin, end, s);
+        else if (dynamic_cast<eavlIntArray*>(arr))
+            AccumulateStats((const int*)vals, ncomp, begin, end, s);
+        else if (dynamic_cast<eavlByteArray*>(arr))
+            AccumulateStats((const unsigned char*)vals, ncomp, begin, end, s);
+        else
+        {
+            for (int i=begin; i<end; ++i)
+            {
+                double mag2 = 0;
+                for (int c=0; c<ncomp; ++c)
+                {
+                    double v = arr->GetComponentAsDouble(i, c);
+                    s.minval = std::min(s.minval, v);
+                    s.maxval = std::max(s.maxval, v);
+                    if (v > 0)
+                        s.minpos = std::min(s.minpos, v);
+                    mag2 += v*v;
+                }
+                s.minmag = std::min(s.minmag, sqrt(mag2));
+                s.maxmag = std::max(s.maxmag, sqrt(mag2));
+            }
+        }
+        return s;
+    }
+};
+
+static void
+MergeBlockStats(FieldStats &result, const FieldStats &s)
+{
+    result.Merge(s);
+}
+
+// ****************************************************************************
+// Method:  FieldStatsCache::Compute
+//
+// Purpose:
+///   Compute the stats of an array in one pass over its values, split
+///   into blocks across the thread pool.
+//
+// Arguments:
+//   arr        the array
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+FieldStats
+FieldStatsCache::Compute(eavlArray *arr)
+{
+    int ntuples = arr->GetNumberOfTuples();
+    if (ntuples == 0)
+        return FieldStats();
+
+    // make sure the values are on the host before the threads start
+    BlockStats blockStats;
+    blockStats.arr = arr;
+    blockStats.vals = NULL;
+    if (dynamic_cast<eavlFloatArray*>(arr) ||
+        dynamic_cast<eavlIntArray*>(arr) ||
+        dynamic_cast<eavlByteArray*>(arr))
+    {
+        blockStats.vals = arr->GetHostArray();
+    }
+
+    int nblocks = (ntuples + statsBlockSize - 1) / statsBlockSize;
+    if (nblocks == 1)
+        return blockStats(0);
+
+    std::vector<int> blocks;
+    for (int b=0; b<nblocks; ++b)
+        blocks.push_back(b);
+    return QtConcurrent::blockingMappedReduced<FieldStats>(blocks, blockStats,
+                                                           MergeBlockStats);
+}
+
+// ****************************************************************************
+// Method:  FieldStatsCache::Get
+//
+// Purpose:
+///   Get the stats for an array, computing them if we haven't yet.
+///   Two threads asking for the same new array at once may both
+///   compute it, which is harmless.
+//
+// Arguments:
+//   arr        the array
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+FieldStats
+FieldStatsCache::Get(eavlArray *arr)
+{
+    {
+        QMutexLocker locker(&lock);
+        std::map<eavlArray*,FieldStats>::iterator it = stats.find(arr);
+        if (it != stats.end())
+            return it->second;
+    }
+
+    // don't hold the lock while we compute
+    FieldStats s = Compute(arr);
+
+    QMutexLocker locker(&lock);
+    stats[arr] = s;
+    return s;
+}
+
+// ****************************************************************************
+// Method:  FieldStatsCache::Forget
+//
+// Purpose:
+///   Drop the stats for an array which is about to be freed, since
+///   a new array may later be created at the same address.
+//
+// Arguments:
+//   arr        the array
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+FieldStatsCache::Forget(eavlArray *arr)
+{
+    QMutexLocker locker(&lock);
+    stats.erase(arr);
+}
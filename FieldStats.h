@@ -0,0 +1,67 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef FIELD_STATS_H
+#define FIELD_STATS_H
+
+#include "STL.h"
+#include "eavlArray.h"
+#include <QMutex>
+
+// ****************************************************************************
+// Struct:  FieldStats
+//
+// Purpose:
+///   The value ranges of an array: the smallest and largest of any
+///   component, and the smallest and largest tuple magnitude.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 23:52:18 EDT 2026
+//   Added the smallest positive value, for logarithmic scales.
+//
+// ****************************************************************************
+struct FieldStats
+{
+    double minval;
+    double maxval;
+    double minpos;
+    double minmag;
+    double maxmag;
+
+  public:
+    FieldStats();
+    void Merge(const FieldStats &s);
+};
+
+// ****************************************************************************
+// Class:  FieldStatsCache
+//
+// Purpose:
+///   Computes the FieldStats of an array the first time someone asks,
+///   in one multithreaded pass, and remembers them.  Pipeline results
+///   are never changed once computed (see CreateCopyOnWriteInput), so
+///   an array's stats stay good until it's freed, at which point the
+///   ResultCache tells us to forget them.  (For an importer's array,
+///   that's when the cache stops using it.)  This may be called from
+///   any thread.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+class FieldStatsCache
+{
+  protected:
+    static QMutex                          lock;
+    static std::map<eavlArray*,FieldStats> stats;
+
+  public:
+    static FieldStats Get(eavlArray *arr);
+    static void       Forget(eavlArray *arr);
+
+    static FieldStats Compute(eavlArray *arr);
+};
+
+#endif
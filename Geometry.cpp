@@ -0,0 +1,479 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "Geometry.h"
+
+#include <eavlCellSetAllStructured.h>
+#include <eavlCellSetExplicit.h>
+#include <eavlCoordinates.h>
+#include <eavlLogicalStructureRegular.h>
+
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+/// How far the curvilinear warp moves a point, relative to the mesh size.
+static const float geomWarp = 0.15f;
+
+/// Centers of the Gaussians in the "blobs" field, and their width.
+static const float blobCenters[3][3] = {{-0.4f, -0.3f, -0.2f},
+                                        { 0.5f,  0.1f,  0.3f},
+                                        {-0.1f,  0.5f,  0.6f}};
+static const float blobWidth = 0.3f;
+
+// ****************************************************************************
+// Function:  HashNoise
+//
+// Purpose:
+///   A value in [0,1) which looks random but depends only on the index.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static float
+HashNoise(long long index)
+{
+    unsigned long long h = (unsigned long long)index * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    return float(h >> 40) / float(1 << 24);
+}
+
+// ****************************************************************************
+// Struct:  PlaneFiller
+//
+// Purpose:
+///   Function object for QtConcurrent filling in one z plane of the
+///   point coordinates or of a field of a chunk.  The noise field is
+///   cellular, so for it these are planes of cells, not points.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct PlaneFiller
+{
+    typedef void result_type;
+
+    const GeometrySource *src;
+    /// the field's index in GeometrySource::GetFields (distance, blobs,
+    /// swirl, noise), or -1 for the coordinates
+    int                   field;
+    int                   k0;
+    float                *vals;
+
+    void operator()(int &k)
+    {
+        int ni = src->GetNI(), nj = src->GetNJ();
+        if (field == 3)
+        {
+            long long offset = (long long)(k-k0) * nj * ni;
+            for (int j=0; j<nj; ++j)
+            {
+                for (int i=0; i<ni; ++i)
+                {
+                    long long global = ((long long)k * nj + j) * ni + i;
+                    vals[offset++] = HashNoise(global);
+                }
+            }
+            return;
+        }
+
+        int ncomp = (field == -1 || field == 2) ? 3 : 1;
+        long long p = (long long)(k-k0) * (nj+1) * (ni+1);
+        for (int j=0; j<=nj; ++j)
+        {
+            for (int i=0; i<=ni; ++i, ++p)
+            {
+                float x, y, z;
+                src->GetPoint(i, j, k, x, y, z);
+                float *v = vals + p*ncomp;
+                float r2 = x*x + y*y + z*z;
+                switch (field)
+                {
+                  case -1:
+                    v[0] = x;
+                    v[1] = y;
+                    v[2] = z;
+                    break;
+                  case 0:
+                    v[0] = sqrt(r2);
+                    break;
+                  case 1:
+                    v[0] = 0;
+                    for (int b=0; b<3; ++b)
+                    {
+                        float dx = x - blobCenters[b][0];
+                        float dy = y - blobCenters[b][1];
+                        float dz = z - blobCenters[b][2];
+                        v[0] += exp(-(dx*dx + dy*dy + dz*dz) /
+                                    (2 * blobWidth * blobWidth));
+                    }
+                    break;
+                  case 2:
+                    v[0] = -y * exp(-r2);
+                    v[1] =  x * exp(-r2);
+                    v[2] = 0.2f * (1 - r2);
+                    break;
+                }
+            }
+        }
+    }
+};
+
+// ****************************************************************************
+// Constructor:  GeometrySource::GeometrySource
+//
+// Arguments:
+//   atts       the shape and size of the mesh
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+GeometrySource::GeometrySource(const GeometryAttributes &atts)
+{
+    if (atts.shape == "rectilinear")
+        shape = Rectilinear;
+    else if (atts.shape == "curvilinear")
+        shape = Curvilinear;
+    else if (atts.shape == "hexahedra")
+        shape = Hexahedra;
+    else if (atts.shape == "tetrahedra")
+        shape = Tetrahedra;
+    else
+        throw eavlException("unknown shape " + atts.shape + "; expected "
+                            "rectilinear, curvilinear, hexahedra, or "
+                            "tetrahedra");
+
+    ni = atts.ni;
+    nj = atts.nj;
+    nk = atts.nk;
+    nchunks = atts.nchunks;
+    if (ni < 1 || nj < 1 || nk < 1)
+        throw eavlException("a generated mesh needs at least one cell "
+                            "in each dimension");
+    if (nchunks < 1 || nchunks > nk)
+        throw eavlException("a generated mesh needs between one chunk "
+                            "and one chunk per cell in z");
+
+    // each chunk is indexed with ints, like any other data set
+    long long slab = (nk + nchunks - 1) / nchunks;
+    long long npts = (long long)(ni+1) * (nj+1) * (slab+1);
+    long long ncells = (long long)ni * nj * slab * (shape==Tetrahedra ? 6 : 1);
+    if (npts * 3 > INT_MAX || ncells * 8 > INT_MAX)
+        throw eavlException("chunks of the generated mesh are too large; "
+                            "use more of them");
+
+    key = GetKey(atts);
+}
+
+// ****************************************************************************
+// Destructor:  GeometrySource::~GeometrySource
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+GeometrySource::~GeometrySource()
+{
+}
+
+// ****************************************************************************
+// Method:  GeometrySource::GetKey
+//
+// Purpose:
+///   A string identifying the mesh these attributes generate, for the
+///   ResultCache.
+//
+// Arguments:
+//   atts       the shape and size of the mesh
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::string
+GeometrySource::GetKey(const GeometryAttributes &atts)
+{
+    ostringstream os;
+    os << "Geometry:" << atts.shape << ":"
+       << atts.ni << "x" << atts.nj << "x" << atts.nk << ":"
+       << atts.nchunks << ":";
+    return os.str();
+}
+
+// ****************************************************************************
+// Method:  GeometrySource::GetFields
+//
+// Purpose:
+///   The fields of a generated mesh; they're the same for any shape.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::vector<std::string>
+GeometrySource::GetFields()
+{
+    std::vector<std::string> fields;
+    fields.push_back("distance");
+    fields.push_back("blobs");
+    fields.push_back("swirl");
+    fields.push_back("noise");
+    return fields;
+}
+
+int
+GeometrySource::GetNumChunks(const std::string &)
+{
+    return nchunks;
+}
+
+vector<string>
+GeometrySource::GetMeshList()
+{
+    return vector<string>(1, "mesh");
+}
+
+vector<string>
+GeometrySource::GetFieldList(const std::string &)
+{
+    return GetFields();
+}
+
+vector<string>
+GeometrySource::GetCellSetList(const std::string &)
+{
+    return vector<string>(1, "cells");
+}
+
+// ****************************************************************************
+// Method:  GeometrySource::GetChunkExtents
+//
+// Purpose:
+///   The range of z cell planes in a chunk; it has points k0 to k1.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+GeometrySource::GetChunkExtents(int chunk, int &k0, int &k1) const
+{
+    k0 = int((long long)nk * chunk / nchunks);
+    k1 = int((long long)nk * (chunk+1) / nchunks);
+}
+
+// ****************************************************************************
+// Method:  GeometrySource::GetPoint
+//
+// Purpose:
+///   The position of point (i,j,k) of the whole mesh.  The curvilinear
+///   warp moves each coordinate by a function of a different one, which
+///   is small enough that no cell turns inside out.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+GeometrySource::GetPoint(int i, int j, int k,
+                         float &x, float &y, float &z) const
+{
+    x = -1.f + 2.f * float(i) / float(ni);
+    y = -1.f + 2.f * float(j) / float(nj);
+    z = -1.f + 2.f * float(k) / float(nk);
+    if (shape == Curvilinear)
+    {
+        const float pi = 3.14159265f;
+        float wx = x + geomWarp * sin(pi * y);
+        float wy = y + geomWarp * sin(pi * z);
+        float wz = z + geomWarp * sin(pi * x);
+        x = wx;
+        y = wy;
+        z = wz;
+    }
+}
+
+// ****************************************************************************
+// Method:  GeometrySource::GetMesh
+//
+// Purpose:
+///   Generate the mesh of a chunk, without any fields.
+//
+// Arguments:
+//   name       the mesh name
+//   chunk      the chunk index
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlDataSet *
+GeometrySource::GetMesh(const string &name, int chunk)
+{
+    if (name != "mesh")
+        throw eavlException("a generated mesh has no mesh named " + name);
+    if (chunk < 0 || chunk >= nchunks)
+        throw eavlException("no such chunk in the generated mesh");
+
+    int k0, k1;
+    GetChunkExtents(chunk, k0, k1);
+    int nx = ni+1, ny = nj+1, nz = k1-k0+1;
+
+    eavlDataSet *ds = new eavlDataSet;
+    ds->SetNumPoints(nx * ny * nz);
+
+    eavlRegularStructure reg;
+    reg.SetNodeDimension3D(nx, ny, nz);
+    eavlLogicalStructureRegular *log = NULL;
+    if (shape == Rectilinear || shape == Curvilinear)
+    {
+        log = new eavlLogicalStructureRegular(3, reg);
+        ds->SetLogicalStructure(log);
+    }
+
+    eavlCoordinatesCartesian *coords =
+        new eavlCoordinatesCartesian(log,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    if (shape == Rectilinear)
+    {
+        const char *axisnames[3] = {"xcoord", "ycoord", "zcoord"};
+        int dims[3] = {nx, ny, nz};
+        for (int d=0; d<3; ++d)
+        {
+            eavlFloatArray *arr = new eavlFloatArray(axisnames[d], 1, dims[d]);
+            for (int i=0; i<dims[d]; ++i)
+            {
+                float x, y, z;
+                GetPoint(d==0 ? i : 0, d==1 ? i : 0, d==2 ? k0+i : 0, x, y, z);
+                arr->SetValue(i, d==0 ? x : (d==1 ? y : z));
+            }
+            ds->AddField(new eavlField(1, arr, eavlField::ASSOC_LOGICALDIM, d));
+            coords->SetAxis(d, new eavlCoordinateAxisField(axisnames[d]));
+        }
+    }
+    else
+    {
+        eavlFloatArray *pts = new eavlFloatArray("coords", 3, nx * ny * nz);
+        PlaneFiller filler;
+        filler.src = this;
+        filler.field = -1;
+        filler.k0 = k0;
+        filler.vals = (float*)pts->GetHostArray();
+        std::vector<int> planes;
+        for (int k=k0; k<=k1; ++k)
+            planes.push_back(k);
+        QtConcurrent::blockingMap(planes, filler);
+
+        ds->AddField(new eavlField(1, pts, eavlField::ASSOC_POINTS));
+        for (int d=0; d<3; ++d)
+            coords->SetAxis(d, new eavlCoordinateAxisField("coords", d));
+    }
+    ds->AddCoordinateSystem(coords);
+
+    if (shape == Rectilinear || shape == Curvilinear)
+    {
+        ds->AddCellSet(new eavlCellSetAllStructured("cells", reg));
+        return ds;
+    }
+
+    // the explicit connectivity can only grow a cell at a time
+    static const int kuhnTets[6][4] = {{0,1,2,6}, {0,2,3,6}, {0,3,7,6},
+                                       {0,7,4,6}, {0,4,5,6}, {0,5,1,6}};
+    eavlExplicitConnectivity conn;
+    for (int k=0; k<nz-1; ++k)
+    {
+        for (int j=0; j<nj; ++j)
+        {
+            for (int i=0; i<ni; ++i)
+            {
+                int p = (k*ny + j)*nx + i;
+                int hex[8] = { p,          p+1,          p+nx+1,          p+nx,
+                               p+nx*ny,    p+nx*ny+1,    p+nx*ny+nx+1,    p+nx*ny+nx };
+                if (shape == Hexahedra)
+                {
+                    conn.AddElement(EAVL_HEX, 8, hex);
+                    continue;
+                }
+                // six tetrahedra around the main diagonal, which split
+                // each face the same way its neighbor does
+                for (int t=0; t<6; ++t)
+                {
+                    int tet[4] = {hex[kuhnTets[t][0]], hex[kuhnTets[t][1]],
+                                  hex[kuhnTets[t][2]], hex[kuhnTets[t][3]]};
+                    conn.AddElement(EAVL_TET, 4, tet);
+                }
+            }
+        }
+    }
+    eavlCellSetExplicit *cells = new eavlCellSetExplicit("cells", 3);
+    cells->SetCellNodeConnectivity(conn);
+    ds->AddCellSet(cells);
+    return ds;
+}
+
+// ****************************************************************************
+// Method:  GeometrySource::GetField
+//
+// Purpose:
+///   Generate a field of a chunk.
+//
+// Arguments:
+//   name       the field name
+//   mesh       the mesh name
+//   chunk      the chunk index
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlField *
+GeometrySource::GetField(const string &name, const string &mesh, int chunk)
+{
+    if (mesh != "mesh")
+        throw eavlException("a generated mesh has no mesh named " + mesh);
+    if (chunk < 0 || chunk >= nchunks)
+        throw eavlException("no such chunk in the generated mesh");
+
+    std::vector<std::string> fields = GetFields();
+    int field = std::find(fields.begin(), fields.end(), name) - fields.begin();
+    if (field == (int)fields.size())
+        throw eavlException("a generated mesh has no field named " + name);
+
+    int k0, k1;
+    GetChunkExtents(chunk, k0, k1);
+    bool cellular = (name == "noise");
+    int ncomp = (name == "swirl") ? 3 : 1;
+    int nvals = cellular ? ni * nj * (k1-k0) : (ni+1) * (nj+1) * (k1-k0+1);
+
+    eavlFloatArray *arr = new eavlFloatArray(name, ncomp, nvals);
+    PlaneFiller filler;
+    filler.src = this;
+    filler.field = field;
+    filler.k0 = k0;
+    filler.vals = (float*)arr->GetHostArray();
+    std::vector<int> planes;
+    for (int k=k0; k<(cellular ? k1 : k1+1); ++k)
+        planes.push_back(k);
+    QtConcurrent::blockingMap(planes, filler);
+
+    if (cellular)
+        return new eavlField(0, arr, eavlField::ASSOC_CELL_SET, "cells");
+    return new eavlField(1, arr, eavlField::ASSOC_POINTS);
+}
@@ -0,0 +1,109 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include "STL.h"
+#include "Attribute.h"
+#include "eavlImporter.h"
+
+// ****************************************************************************
+// Class:  GeometryAttributes
+//
+// Purpose:
+///   Attributes for a generated mesh: its shape, its size in cells, and
+///   how many chunks to split it into.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+class GeometryAttributes : public Attribute
+{
+  public:
+    string shape;
+    int ni, nj, nk;
+    int nchunks;
+  public:
+    virtual const char *GetType() {return "GeometryAttributes";}
+    GeometryAttributes() : Attribute()
+    {
+        shape = "rectilinear";
+        ni = nj = nk = 64;
+        nchunks = 4;
+    }
+    virtual ~GeometryAttributes()
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("shape", shape);
+        Add("ni", ni);
+        Add("nj", nj);
+        Add("nk", nk);
+        Add("nchunks", nchunks);
+    }
+};
+
+// ****************************************************************************
+// Class:  GeometrySource
+//
+// Purpose:
+///   An importer which makes up its data instead of reading it.  The mesh
+///   covers [-1,1] in each dimension with ni x nj x nk cells, split into
+///   slabs along z for the chunks.  Its shape is one of
+///     rectilinear   axis-aligned structured grid
+///     curvilinear   the same grid, bent by a smooth warp
+///     hexahedra     explicit hexahedra on the rectilinear grid's points
+///     tetrahedra    each of those hexahedra split into six tetrahedra
+///   and it has these fields:
+///     distance      (nodal) distance from the origin
+///     blobs         (nodal) a sum of a few Gaussians
+///     swirl         (nodal) a 3-component vortex around z
+///     noise         (cellular) hashed from the cell's global index, so
+///                   it's the same whatever the chunking
+///
+///   Nothing is generated until a chunk or field is asked for, so a
+///   huge mesh only costs what the pipeline actually touches.  The
+///   values are filled in across the thread pool, and different chunks
+///   may be generated from different threads at once.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+class GeometrySource : public eavlImporter
+{
+  public:
+    enum Shape { Rectilinear, Curvilinear, Hexahedra, Tetrahedra };
+
+  protected:
+    Shape shape;
+    int   ni, nj, nk;
+    int   nchunks;
+    std::string key;
+
+  public:
+    GeometrySource(const GeometryAttributes &atts);
+    virtual ~GeometrySource();
+
+    const std::string &GetKey() { return key; }
+    static std::string GetKey(const GeometryAttributes &atts);
+    static std::vector<std::string> GetFields();
+
+    virtual int            GetNumChunks(const std::string &mesh);
+    virtual vector<string> GetMeshList();
+    virtual vector<string> GetFieldList(const std::string &mesh);
+    virtual vector<string> GetCellSetList(const std::string &mesh);
+    virtual eavlDataSet   *GetMesh(const string &name, int chunk);
+    virtual eavlField     *GetField(const string &name, const string &mesh,
+                                    int chunk);
+
+    void GetChunkExtents(int chunk, int &k0, int &k1) const;
+    void GetPoint(int i, int j, int k, float &x, float &y, float &z) const;
+    int  GetNI() const { return ni; }
+    int  GetNJ() const { return nj; }
+};
+
+#endif
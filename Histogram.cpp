@@ -0,0 +1,337 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "Histogram.h"
+
+#include <eavlCellSetAllStructured.h>
+#include <eavlCoordinates.h>
+#include <eavlLogicalStructureRegular.h>
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+/// The fewest tuples worth giving a thread of its own.
+static const int histMinPartition = 1 << 16;
+/// Tuples we find the bins of before counting them.
+static const int histBatchSize = 256;
+
+// ****************************************************************************
+// Constructor:  HistogramAxis::HistogramAxis
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+HistogramAxis::HistogramAxis()
+    : nbins(1), logscale(false), lo(0), hi(0), scale(0)
+{
+}
+
+// ****************************************************************************
+// Method:  HistogramAxis::SetRange
+//
+// Purpose:
+///   Span the range of a field (e.g. over all chunks) with n bins.  A
+///   log scale starts at the smallest positive value; anything below
+///   that isn't counted.
+//
+// Arguments:
+//   stats      the field's stats (see FieldStatsCache)
+//   n          the number of bins
+//   log        true for a log scale
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+HistogramAxis::SetRange(const FieldStats &stats, int n, bool log)
+{
+    if (n < 1)
+        throw eavlException("A histogram needs at least one bin.");
+    nbins = n;
+    logscale = log;
+    if (logscale)
+    {
+        if (!(stats.maxval > 0))
+            throw eavlException("A log scale needs positive values.");
+        lo = log10(stats.minpos);
+        hi = log10(stats.maxval);
+    }
+    else
+    {
+        if (stats.minval > stats.maxval)
+            throw eavlException("There are no values to bin.");
+        lo = stats.minval;
+        hi = stats.maxval;
+    }
+    // with a single value, everything goes in the first bin
+    scale = (hi > lo) ? double(nbins) / (hi - lo) : 0.;
+}
+
+// ****************************************************************************
+// Method:  HistogramAxis::GetEdge
+//
+// Purpose:
+///   The low edge of bin i, or the high edge of the last bin for nbins.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+double
+HistogramAxis::GetEdge(int i) const
+{
+    double e = (hi > lo) ? lo + (hi - lo) * double(i) / double(nbins)
+                         : lo + double(i);
+    return logscale ? pow(10., e) : e;
+}
+
+// ****************************************************************************
+// Function:  FindBins
+//
+// Purpose:
+///   Find the bins of a range of tuples of a plain array of values (the
+///   first component), with -1 for values in no bin.  This is kept
+///   apart from the counting so the loop has no stores the compiler
+///   can't see through, and it can vectorize it.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+template <class T>
+static void
+FindBins(const T *vals, int ncomp, int begin, int end,
+         const HistogramAxis &ax, int *bins)
+{
+    const HistogramAxis a = ax;
+    for (int i=begin; i<end; ++i)
+        bins[i-begin] = a.GetBin(double(vals[long(i)*ncomp]));
+}
+
+static void
+FindBins(eavlArray *arr, const void *vals, int begin, int end,
+         const HistogramAxis &ax, int *bins)
+{
+    int ncomp = arr->GetNumberOfComponents();
+    if (!vals)
+    {
+        for (int i=begin; i<end; ++i)
+            bins[i-begin] = ax.GetBin(arr->GetComponentAsDouble(i, 0));
+    }
+    else if (dynamic_cast<eavlFloatArray*>(arr))
+        FindBins((const float*)vals, ncomp, begin, end, ax, bins);
+    else if (dynamic_cast<eavlIntArray*>(arr))
+        FindBins((const int*)vals, ncomp, begin, end, ax, bins);
+    else
+        FindBins((const unsigned char*)vals, ncomp, begin, end, ax, bins);
+}
+
+/// The values of an array we can read directly, or NULL.
+static const void *
+GetDirectValues(eavlArray *arr)
+{
+    if (dynamic_cast<eavlFloatArray*>(arr) ||
+        dynamic_cast<eavlIntArray*>(arr) ||
+        dynamic_cast<eavlByteArray*>(arr))
+    {
+        return arr->GetHostArray();
+    }
+    return NULL;
+}
+
+// ****************************************************************************
+// Struct:  PartitionBinner
+//
+// Purpose:
+///   Function object for QtConcurrent counting one partition of the
+///   tuples into a private histogram, which the reduce step adds up.
+///   There are only a few partitions per thread, so the private
+///   histograms stay small even for a large 2D histogram.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct PartitionBinner
+{
+    typedef std::vector<int> result_type;
+
+    eavlArray           *x;
+    const void          *xvals;
+    const HistogramAxis *ax;
+    eavlArray           *y;
+    const void          *yvals;
+    const HistogramAxis *ay;
+    int                  ntuples;
+    int                  npartitions;
+
+    std::vector<int> operator()(int partition)
+    {
+        int nx = ax->nbins;
+        int ny = ay ? ay->nbins : 1;
+        std::vector<int> counts(nx * ny, 0);
+
+        int begin = int((long long)ntuples * partition / npartitions);
+        int end = int((long long)ntuples * (partition+1) / npartitions);
+        int xbins[histBatchSize], ybins[histBatchSize];
+        for (int b=begin; b<end; b+=histBatchSize)
+        {
+            int e = std::min(b + histBatchSize, end);
+            FindBins(x, xvals, b, e, *ax, xbins);
+            if (!y)
+            {
+                for (int i=0; i<e-b; ++i)
+                    if (xbins[i] >= 0)
+                        counts[xbins[i]]++;
+                continue;
+            }
+            FindBins(y, yvals, b, e, *ay, ybins);
+            for (int i=0; i<e-b; ++i)
+                if (xbins[i] >= 0 && ybins[i] >= 0)
+                    counts[ybins[i]*nx + xbins[i]]++;
+        }
+        return counts;
+    }
+};
+
+static void
+AddPartitionCounts(std::vector<double> &result, const std::vector<int> &counts)
+{
+    if (result.empty())
+        result.resize(counts.size(), 0.);
+    for (size_t i=0; i<counts.size(); ++i)
+        result[i] += counts[i];
+}
+
+// ****************************************************************************
+// Function:  BinValues
+//
+// Purpose:
+///   Add the tuples of a field (and, for a 2D histogram, the matching
+///   tuples of a second field) to a histogram, across the thread pool.
+///   The counts are laid out with the x bins varying fastest.
+//
+// Arguments:
+//   x          the field for the first axis
+//   ax         the first axis
+//   y          the field for the second axis, or NULL
+//   ay         the second axis, or NULL
+//   counts     the histogram to add to
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+BinValues(eavlArray *x, const HistogramAxis &ax,
+          eavlArray *y, const HistogramAxis *ay,
+          std::vector<double> &counts)
+{
+    int ntuples = x->GetNumberOfTuples();
+    if (y && y->GetNumberOfTuples() != ntuples)
+        throw eavlException("The fields for a 2D histogram need to have "
+                            "the same centering.");
+    if (ntuples == 0)
+        return;
+
+    // make sure the values are on the host before the threads start
+    PartitionBinner binner;
+    binner.x = x;
+    binner.xvals = GetDirectValues(x);
+    binner.ax = &ax;
+    binner.y = y;
+    binner.yvals = y ? GetDirectValues(y) : NULL;
+    binner.ay = y ? ay : NULL;
+    binner.ntuples = ntuples;
+    binner.npartitions =
+        std::max(1, std::min(2 * QThread::idealThreadCount(),
+                             ntuples / histMinPartition));
+
+    std::vector<int> partitions;
+    for (int p=0; p<binner.npartitions; ++p)
+        partitions.push_back(p);
+    std::vector<double> sums =
+        QtConcurrent::blockingMappedReduced< std::vector<double> >(
+                                 partitions, binner, AddPartitionCounts);
+
+    counts.resize(sums.size(), 0.);
+    for (size_t i=0; i<sums.size(); ++i)
+        counts[i] += sums[i];
+}
+
+// ****************************************************************************
+// Function:  CreateHistogramDataSet
+//
+// Purpose:
+///   Make a data set of a histogram: a 1D or 2D rectilinear mesh whose
+///   coordinates are the bin edges, with a cell set named "bins" and
+///   the counts as a cell field named "counts".
+//
+// Arguments:
+//   ax         the first axis
+//   ay         the second axis, or NULL for a 1D histogram
+//   counts     the counts, with the x bins varying fastest
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlDataSet *
+CreateHistogramDataSet(const HistogramAxis &ax, const HistogramAxis *ay,
+                       const std::vector<double> &counts)
+{
+    int nx = ax.nbins + 1;
+    int ny = ay ? ay->nbins + 1 : 1;
+
+    eavlDataSet *ds = new eavlDataSet;
+    ds->SetNumPoints(nx * ny);
+
+    eavlRegularStructure reg;
+    if (ay)
+        reg.SetNodeDimension2D(nx, ny);
+    else
+        reg.SetNodeDimension1D(nx);
+    eavlLogicalStructureRegular *log =
+        new eavlLogicalStructureRegular(ay ? 2 : 1, reg);
+    ds->SetLogicalStructure(log);
+
+    eavlFloatArray *xc = new eavlFloatArray("xcoord", 1, nx);
+    for (int i=0; i<nx; ++i)
+        xc->SetValue(i, ax.GetEdge(i));
+    ds->AddField(new eavlField(1, xc, eavlField::ASSOC_LOGICALDIM, 0));
+
+    eavlCoordinatesCartesian *coords;
+    if (ay)
+    {
+        eavlFloatArray *yc = new eavlFloatArray("ycoord", 1, ny);
+        for (int j=0; j<ny; ++j)
+            yc->SetValue(j, ay->GetEdge(j));
+        ds->AddField(new eavlField(1, yc, eavlField::ASSOC_LOGICALDIM, 1));
+        coords = new eavlCoordinatesCartesian(log,
+                                              eavlCoordinatesCartesian::X,
+                                              eavlCoordinatesCartesian::Y);
+        coords->SetAxis(1, new eavlCoordinateAxisField("ycoord"));
+    }
+    else
+    {
+        coords = new eavlCoordinatesCartesian(log,
+                                              eavlCoordinatesCartesian::X);
+    }
+    coords->SetAxis(0, new eavlCoordinateAxisField("xcoord"));
+    ds->AddCoordinateSystem(coords);
+
+    ds->AddCellSet(new eavlCellSetAllStructured("bins", reg));
+
+    eavlFloatArray *arr = new eavlFloatArray("counts", 1, counts.size());
+    for (size_t i=0; i<counts.size(); ++i)
+        arr->SetValue(i, counts[i]);
+    ds->AddField(new eavlField(0, arr, eavlField::ASSOC_CELL_SET, "bins"));
+    return ds;
+}
@@ -0,0 +1,57 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "STL.h"
+#include "eavlArray.h"
+#include "eavlDataSet.h"
+#include "FieldStats.h"
+
+#include <cmath>
+
+// ****************************************************************************
+// Struct:  HistogramAxis
+//
+// Purpose:
+///   The bins along one axis of a histogram, evenly spaced in either the
+///   values or their logarithms.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct HistogramAxis
+{
+    int    nbins;
+    bool   logscale;
+    /// the range, in log10 of the values for a log scale
+    double lo;
+    double hi;
+    double scale;
+
+  public:
+    HistogramAxis();
+    void   SetRange(const FieldStats &stats, int n, bool log);
+    double GetEdge(int i) const;
+
+    /// The bin for a value, or -1 if it isn't in any.
+    int GetBin(double v) const
+    {
+        if (logscale)
+            v = (v > 0) ? log10(v) : lo - 1.;
+        if (!(v >= lo && v <= hi))
+            return -1;
+        int b = int((v - lo) * scale);
+        return (b < nbins) ? b : nbins-1;
+    }
+};
+
+void         BinValues(eavlArray *x, const HistogramAxis &ax,
+                       eavlArray *y, const HistogramAxis *ay,
+                       std::vector<double> &counts);
+eavlDataSet *CreateHistogramDataSet(const HistogramAxis &ax,
+                                    const HistogramAxis *ay,
+                                    const std::vector<double> &counts);
+
+#endif
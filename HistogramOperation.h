@@ -3,33 +3,42 @@
 #define OP_HISTOGRAM_H
 
 #include "Operation.h"
-
-#include <eavlScalarBinFilter.h>
+#include "Histogram.h"
 
 // ****************************************************************************
 // Class:  HistogramAttributes
 //
 // Purpose:
-///   Attributes for the surface normal operation.  Currently, just
-///   a boolean flag whether to add the nodal version, or just have
-///   face normals.
+///   Attributes for the histogram operation: the field to bin and how,
+///   and optionally a second field for a 2D (joint) histogram.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    January 17, 2013
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 23:52:18 EDT 2026
+//   Added log scales and the second field.
+//
 // ****************************************************************************
 class HistogramAttributes : public Attribute
 {
   public:
     string field;
     int nbins;
+    bool logbins;
+    string field2;
+    int nbins2;
+    bool logbins2;
   public:
     virtual const char *GetType() {return "HistogramAttributes";}
     HistogramAttributes() : Attribute()
     {
         field = "(default)";
         nbins = 10;
+        logbins = false;
+        field2 = "(none)";
+        nbins2 = 10;
+        logbins2 = false;
     }
     virtual ~HistogramAttributes()
     {
@@ -38,6 +47,10 @@ class HistogramAttributes : public Attribute
     {
         Add("field", field);
         Add("nbins", nbins);
+        Add("logbins", logbins);
+        Add("field2", field2);
+        Add("nbins2", nbins2);
+        Add("logbins2", logbins2);
     }
     
 };
@@ -46,26 +59,29 @@ class HistogramAttributes : public Attribute
 // Class:  HistogramOperation
 //
 // Purpose:
-///   Operation that creates a new field that set that is the surface
-///   normals from another cell set.
-///   Note: this currently has no settings.
+///   Operation that counts the values of a field into bins, or the
+///   values of two fields into a 2D grid of bins.  All chunks go into
+///   one histogram over the fields' full ranges, which ends up in the
+///   first chunk of the output; the other chunks are empty.  The output
+///   is a 1D or 2D mesh with a "counts" field on its "bins" cell set.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    January 17, 2013
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 23:52:18 EDT 2026
+//   Bin in parallel ourselves instead of with eavlScalarBinFilter, and
+//   combine the chunks.  Added log scales and 2D histograms.
 //
 // ****************************************************************************
 class HistogramOperation : public Operation
 {
     HistogramAttributes *atts;
-    eavlScalarBinFilter *filter;
   public:
     HistogramOperation()
         : Operation()
     {
         atts = new HistogramAttributes;
-        filter = new eavlScalarBinFilter;
     }
     virtual std::string GetOperationName()
     {
@@ -78,7 +94,18 @@ class HistogramOperation : public Operation
     virtual std::string GetOperationInfo()
     {
         ostringstream os;
-        os << atts->field << " in " << atts->nbins << " bins";
+        os << atts->field;
+        if (atts->logbins)
+            os << "(log)";
+        if (Is2D())
+        {
+            os << " x " << atts->field2;
+            if (atts->logbins2)
+                os << "(log)";
+            os << " in " << atts->nbins << "x" << atts->nbins2 << " bins";
+        }
+        else
+            os << " in " << atts->nbins << " bins";
         return os.str();
     }
     virtual Attribute *GetSettings()
@@ -90,6 +117,8 @@ class HistogramOperation : public Operation
         std::vector<std::string> vars;
         if (atts->field != "(default)")
             vars.push_back(atts->field);
+        if (Is2D())
+            vars.push_back(atts->field2);
         return vars;
     }
     virtual std::vector<std::string> GetOutputVariables()
@@ -98,14 +127,71 @@ class HistogramOperation : public Operation
         vars.push_back("counts");
         return vars;
     }
-    virtual void Execute()
+    bool Is2D()
+    {
+        return atts->field2 != "(none)" && atts->field2 != "";
+    }
+    static eavlArray *FindArray(eavlDataSet *ds, const std::string &name)
+    {
+        for (int i=0; i<ds->GetNumFields(); ++i)
+        {
+            if (ds->GetField(i)->GetArray()->GetName() == name)
+                return ds->GetField(i)->GetArray();
+        }
+        return NULL;
+    }
+    virtual bool CombinesChunks()
     {
-        filter->SetInput(input);
-        filter->SetField(atts->field);
-        filter->SetNumBins(atts->nbins);
-        filter->Execute();
+        return true;
+    }
+    virtual eavlDataSet *Execute(eavlDataSet *input)
+    {
+        return ExecuteCombined(std::vector<eavlDataSet*>(1, input))[0];
+    }
+    virtual std::vector<eavlDataSet*> ExecuteCombined(const std::vector<eavlDataSet*> &inputs)
+    {
+        // the bins span the range over all chunks; the stats are cached
+        // per array, so this usually doesn't touch the values
+        bool twod = Is2D();
+        std::vector<eavlArray*> xs(inputs.size()), ys(inputs.size());
+        FieldStats xstats, ystats;
+        for (size_t c=0; c<inputs.size(); ++c)
+        {
+            xs[c] = FindArray(inputs[c], atts->field);
+            ys[c] = twod ? FindArray(inputs[c], atts->field2) : NULL;
+            // e.g. an isosurface may miss some chunks entirely
+            if ((!xs[c] || (twod && !ys[c])) && inputs[c]->GetNumPoints() == 0)
+            {
+                xs[c] = ys[c] = NULL;
+                continue;
+            }
+            if (!xs[c])
+                throw eavlException("Couldn't find field " + atts->field);
+            if (twod && !ys[c])
+                throw eavlException("Couldn't find field " + atts->field2);
+            xstats.Merge(FieldStatsCache::Get(xs[c]));
+            if (twod)
+                ystats.Merge(FieldStatsCache::Get(ys[c]));
+        }
+
+        HistogramAxis ax, ay;
+        ax.SetRange(xstats, atts->nbins, atts->logbins);
+        if (twod)
+            ay.SetRange(ystats, atts->nbins2, atts->logbins2);
+
+        std::vector<double> counts(ax.nbins * (twod ? ay.nbins : 1), 0.);
+        for (size_t c=0; c<inputs.size(); ++c)
+        {
+            if (xs[c])
+                BinValues(xs[c], ax, ys[c], twod ? &ay : NULL, counts);
+        }
 
-        output = filter->GetOutput();
+        std::vector<eavlDataSet*> outputs;
+        outputs.push_back(CreateHistogramDataSet(ax, twod ? &ay : NULL,
+                                                 counts));
+        for (size_t c=1; c<inputs.size(); ++c)
+            outputs.push_back(new eavlDataSet);
+        return outputs;
     }
 };
 
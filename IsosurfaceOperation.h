@@ -3,32 +3,42 @@
 #define OP_ISOSURFACE_H
 
 #include "Operation.h"
+#include "CopyOnWrite.h"
+#include "SpanSpace.h"
 
 #include <eavlIsosurfaceFilter.h>
+#include <eavlCellSetExplicit.h>
+#include <eavlCoordinates.h>
+#include <algorithm>
+#include <set>
 
 // ****************************************************************************
 // Class:  IsosurfaceAttributes
 //
 // Purpose:
-///   Attributes for the isosurface operation.  Currently, one var and one
-///   target value.
+///   Attributes for the isosurface operation.  Currently, one var and
+///   a list of target values.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    August 9, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:31:47 EDT 2026
+//   Allow more than one value.  The setting keeps its old name so
+//   saved pipelines still load.
+//
 // ****************************************************************************
 class IsosurfaceAttributes : public Attribute
 {
   public:
     string field;
-    float value;
+    vector<float> values;
   public:
     virtual const char *GetType() {return "IsosurfaceAttributes";}
     IsosurfaceAttributes() : Attribute()
     {
         field = "(default)";
-        value = -1;
+        values.push_back(-1);
     }
     virtual ~IsosurfaceAttributes()
     {
@@ -36,7 +46,7 @@ class IsosurfaceAttributes : public Attribute
     virtual void AddFields()
     {
         Add("field", field);
-        Add("value", value);
+        Add("value", values);
     }
     
 };
@@ -51,17 +61,36 @@ class IsosurfaceAttributes : public Attribute
 // Creation:    August 9, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   For nodal fields, only give the filter the cells which can contain
+//   the surface, found with a span space index built once per cell set
+//   and field.  Changing the value then costs about as much as the
+//   surface itself instead of a pass over the whole mesh.
+//
+//   Jeremy Meredith, Sun Oct 18 22:31:47 EDT 2026
+//   Extract every value in one execution, sharing one index, and tag
+//   the points with a "level" field giving the index of their value.
+//
+//   Jeremy Meredith, Mon Oct 19 01:53:21 EDT 2026
+//   This is a multi-level extraction, not a single traversal: the
+//   filter runs once per value, but each run only sees the cells the
+//   shared index says that value crosses, so the total is close to the
+//   cost of the surfaces themselves.  Free the levels on every path.
+//
+//   Jeremy Meredith, Mon Oct 19 02:41:09 EDT 2026
+//   For a nodal field, extract every value in a single run of the
+//   filter, over the union of the cells the index finds for each value
+//   (see ExtractLevels).  Only other fields still run once per value.
+//
 // ****************************************************************************
 class IsosurfaceOperation : public Operation
 {
     IsosurfaceAttributes *atts;
-    eavlIsosurfaceFilter *filter;
   public:
     IsosurfaceOperation()
         : Operation()
     {
         atts = new IsosurfaceAttributes;
-        filter = new eavlIsosurfaceFilter;
     }
     virtual std::string GetOperationName()
     {
@@ -74,7 +103,9 @@ class IsosurfaceOperation : public Operation
     virtual std::string GetOperationInfo()
     {
         ostringstream os;
-        os << atts->field << "=" << atts->value;
+        os << atts->field << "=";
+        for (size_t i=0; i<atts->values.size(); ++i)
+            os << (i>0 ? "," : "") << atts->values[i];
         return os.str();        
     }
     virtual Attribute *GetSettings()
@@ -91,6 +122,7 @@ class IsosurfaceOperation : public Operation
     virtual std::vector<std::string> GetOutputVariables()
     {
         std::vector<std::string> vars;
+        vars.push_back("level");
         if (false)
         {
             // these were mostly internal debug fields from
@@ -105,15 +137,540 @@ class IsosurfaceOperation : public Operation
         }
         return vars;
     }
-    virtual void Execute()
+    virtual eavlDataSet *Execute(eavlDataSet *input)
     {
-        filter->SetInput(input);
         ///\todo: assuming cell set 0
-        filter->SetCellSet(input->GetCellSet(0)->GetName());
-        filter->SetField(atts->field);
-        filter->SetIsoValue(atts->value);
-        filter->Execute();
-        output = filter->GetOutput();
+        eavlCellSet *cs = input->GetCellSet(0);
+
+        eavlField *field = NULL;
+        for (int i=0; i<input->GetNumFields(); ++i)
+        {
+            if (input->GetField(i)->GetArray()->GetName() == atts->field)
+                field = input->GetField(i);
+        }
+
+        if (atts->values.empty())
+            throw eavlException("isosurface needs at least one value");
+
+        if (field && field->GetAssociation() == eavlField::ASSOC_POINTS)
+            return ExtractLevels(input, cs, field);
+
+        // without an index, each value is a pass over the whole mesh;
+        // whatever the filter shares with its input isn't ours to free
+        std::set<void*> keep;
+        AddParts(input, keep);
+
+        std::vector<eavlDataSet*> levels;
+        try
+        {
+            for (size_t i=0; i<atts->values.size(); ++i)
+                levels.push_back(ExtractLevel(input, cs, atts->values[i]));
+
+            if (levels.size() == 1)
+            {
+                AddLevelField(levels[0], 0);
+                return levels[0];
+            }
+
+            eavlDataSet *out = MergeLevels(levels, keep);
+            AddParts(out, keep);
+            for (size_t l=0; l<levels.size(); ++l)
+                FreeLevel(levels[l], keep);
+            return out;
+        }
+        catch (...)
+        {
+            for (size_t l=0; l<levels.size(); ++l)
+                FreeLevel(levels[l], keep);
+            throw;
+        }
+    }
+
+  protected:
+    // ************************************************************************
+    // Method:  IsosurfaceOperation::ExtractLevels
+    //
+    // Purpose:
+    ///   Extract the surfaces for every value of a nodal field in one
+    ///   run of the filter.  The span space index (built the first time,
+    ///   then shared by every value) gives the cells each value crosses;
+    ///   we stack those, each level's cells on their own copy of their
+    ///   points with the field shifted by the level's value, so a single
+    ///   traversal at zero finds every level's surface.  A "level" field
+    ///   on the copies comes through the filter to tag the output, and we
+    ///   shift the field back with it.
+    //
+    // Arguments:
+    //   input      the input data set
+    //   cs         the cell set to contour
+    //   field      the nodal field
+    //
+    // Programmer:  Jeremy Meredith
+    // Creation:    October 18, 2026
+    //
+    // Modifications:
+    // ************************************************************************
+    eavlDataSet *ExtractLevels(eavlDataSet *input, eavlCellSet *cs,
+                               eavlField *field)
+    {
+        SpanSpaceIndex *index = SpanSpaceIndex::Get(cs, field->GetArray());
+        size_t nlevels = atts->values.size();
+        std::vector< std::vector<int> > cells(nlevels);
+        size_t total = 0;
+        for (size_t l=0; l<nlevels; ++l)
+        {
+            index->GetActiveCells(atts->values[l], cells[l]);
+            total += cells[l].size();
+        }
+        // the filter needs at least one cell; any inactive one gives
+        // the same empty output as the whole mesh would
+        if (total == 0 && cs->GetNumCells() > 0)
+            cells[0].push_back(0);
+
+        eavlDataSet *stack = CreateLevelStack(input, cs, field, cells);
+        eavlIsosurfaceFilter filter;
+        filter.SetInput(stack);
+        filter.SetCellSet(cs->GetName());
+        filter.SetField(atts->field);
+        filter.SetIsoValue(0.);
+        try
+        {
+            QMutexLocker lock(&eavlExecutorMutex);
+            filter.Execute();
+        }
+        catch (...)
+        {
+            FreeLevel(stack, std::set<void*>());
+            throw;
+        }
+
+        // whatever the filter passed through from the stack is now
+        // the output's
+        eavlDataSet *out = filter.GetOutput();
+        std::set<void*> keep;
+        AddParts(out, keep);
+        FreeLevel(stack, keep);
+
+        eavlArray *level = NULL;
+        eavlArray *value = NULL;
+        for (int i=0; i<out->GetNumFields(); ++i)
+        {
+            eavlField *f = out->GetField(i);
+            if (f->GetAssociation() != eavlField::ASSOC_POINTS)
+                continue;
+            if (f->GetArray()->GetName() == "level")
+                level = f->GetArray();
+            else if (f->GetArray()->GetName() == atts->field)
+                value = f->GetArray();
+        }
+        if (!level)
+        {
+            FreeLevel(out, std::set<void*>());
+            throw eavlException("isosurface lost its level field");
+        }
+        int npts = out->GetNumPoints();
+        for (int i=0; i<npts; ++i)
+        {
+            // interpolated between two copies of the same level, so
+            // only rounding separates it from that level
+            int l = int(level->GetComponentAsDouble(i, 0) + 0.5);
+            l = std::max(0, std::min(int(nlevels)-1, l));
+            level->SetComponentFromDouble(i, 0, l);
+            if (value)
+                for (int c=0; c<value->GetNumberOfComponents(); ++c)
+                    value->SetComponentFromDouble(i, c,
+                               value->GetComponentAsDouble(i, c) +
+                               atts->values[l]);
+        }
+        return out;
+    }
+
+    // ************************************************************************
+    // Method:  IsosurfaceOperation::CreateLevelStack
+    //
+    // Purpose:
+    ///   Create the input for ExtractLevels: for each level, the cells
+    ///   it crosses, on new points copied from the ones they use, with
+    ///   the nodal fields copied, the contoured field less the level's
+    ///   value, and a nodal "level" field.  Cell fields on the cell set
+    ///   are copied for the stacked cells; other fields are left out.
+    ///   Everything in it is new.
+    //
+    // Arguments:
+    //   input      the input data set
+    //   cs         the cell set to contour
+    //   field      the nodal field
+    //   cells      the cells each level crosses
+    //
+    // Programmer:  Jeremy Meredith
+    // Creation:    October 18, 2026
+    //
+    // Modifications:
+    // ************************************************************************
+    eavlDataSet *CreateLevelStack(eavlDataSet *input, eavlCellSet *cs,
+                                  eavlField *field,
+                                  const std::vector< std::vector<int> > &cells)
+    {
+        // the input point and level of each stacked point, and the
+        // input cell of each stacked cell
+        std::vector<int> source, pointLevel, cellSource;
+        std::vector<int> newId(input->GetNumPoints(), -1);
+        eavlExplicitConnectivity conn;
+        for (size_t l=0; l<cells.size(); ++l)
+        {
+            size_t first = source.size();
+            for (size_t c=0; c<cells[l].size(); ++c)
+            {
+                // the cell's own index array is sized for any cell
+                eavlCell cell = cs->GetCellNodes(cells[l][c]);
+                for (int j=0; j<cell.numIndices; ++j)
+                {
+                    int &id = newId[cell.indices[j]];
+                    if (id < 0)
+                    {
+                        id = source.size();
+                        source.push_back(cell.indices[j]);
+                        pointLevel.push_back(l);
+                    }
+                    cell.indices[j] = id;
+                }
+                conn.AddElement(cell.type, cell.numIndices, cell.indices);
+                cellSource.push_back(cells[l][c]);
+            }
+            for (size_t i=first; i<source.size(); ++i)
+                newId[source[i]] = -1;
+        }
+
+        int npts = source.size();
+        eavlDataSet *stack = new eavlDataSet;
+        stack->SetNumPoints(npts);
+
+        eavlFloatArray *coords = new eavlFloatArray("coords", 3, npts);
+        for (int i=0; i<npts; ++i)
+            for (int d=0; d<3; ++d)
+                coords->SetComponentFromDouble(i, d,
+                                               input->GetPoint(source[i], d));
+        stack->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+        eavlCoordinatesCartesian *cc =
+            new eavlCoordinatesCartesian(NULL,
+                                         eavlCoordinatesCartesian::X,
+                                         eavlCoordinatesCartesian::Y,
+                                         eavlCoordinatesCartesian::Z);
+        for (int d=0; d<3; ++d)
+            cc->SetAxis(d, new eavlCoordinateAxisField("coords", d));
+        stack->AddCoordinateSystem(cc);
+
+        eavlFloatArray *level = new eavlFloatArray("level", 1, npts);
+        for (int i=0; i<npts; ++i)
+            level->SetComponentFromDouble(i, 0, pointLevel[i]);
+        stack->AddField(new eavlField(1, level, eavlField::ASSOC_POINTS));
+
+        for (int f=0; f<input->GetNumFields(); ++f)
+        {
+            eavlField *in = input->GetField(f);
+            eavlArray *arr = in->GetArray();
+            string name = arr->GetName();
+            int nc = arr->GetNumberOfComponents();
+            if (in->GetAssociation() == eavlField::ASSOC_POINTS &&
+                arr->GetNumberOfTuples() == input->GetNumPoints() &&
+                name != "coords" && name != "level")
+            {
+                bool shift = (in == field);
+                eavlFloatArray *out = new eavlFloatArray(name, nc, npts);
+                for (int i=0; i<npts; ++i)
+                    for (int c=0; c<nc; ++c)
+                        out->SetComponentFromDouble(i, c,
+                               arr->GetComponentAsDouble(source[i], c) -
+                               (shift ? atts->values[pointLevel[i]] : 0.f));
+                stack->AddField(new eavlField(in->GetOrder(), out,
+                                              eavlField::ASSOC_POINTS));
+            }
+            else if (in->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                     in->GetAssocCellSet() == cs->GetName())
+            {
+                eavlFloatArray *out = new eavlFloatArray(name, nc,
+                                                         cellSource.size());
+                for (size_t i=0; i<cellSource.size(); ++i)
+                    for (int c=0; c<nc; ++c)
+                        out->SetComponentFromDouble(i, c,
+                               arr->GetComponentAsDouble(cellSource[i], c));
+                stack->AddField(new eavlField(in->GetOrder(), out,
+                                              eavlField::ASSOC_CELL_SET,
+                                              cs->GetName()));
+            }
+        }
+
+        eavlCellSetExplicit *stacked =
+            new eavlCellSetExplicit(cs->GetName(), cs->GetDimensionality());
+        stacked->SetCellNodeConnectivity(conn);
+        stack->AddCellSet(stacked);
+        return stack;
+    }
+
+    // ************************************************************************
+    // Method:  IsosurfaceOperation::ExtractLevel
+    //
+    // Purpose:
+    ///   Extract the surface for one value of a field the span space
+    ///   index can't serve, from the whole mesh.
+    //
+    // Programmer:  Jeremy Meredith
+    // Creation:    October 18, 2026
+    //
+    // Modifications:
+    //   Jeremy Meredith, Mon Oct 19 02:41:09 EDT 2026
+    //   Nodal fields go through ExtractLevels instead.
+    //
+    // ************************************************************************
+    eavlDataSet *ExtractLevel(eavlDataSet *input, eavlCellSet *cs,
+                              float value)
+    {
+        eavlIsosurfaceFilter filter;
+        filter.SetInput(input);
+        filter.SetCellSet(cs->GetName());
+        filter.SetField(atts->field);
+        filter.SetIsoValue(value);
+        {
+            QMutexLocker lock(&eavlExecutorMutex);
+            filter.Execute();
+        }
+        return filter.GetOutput();
+    }
+
+    // ************************************************************************
+    // Method:  IsosurfaceOperation::AddLevelField
+    //
+    // Purpose:
+    ///   Add the nodal "level" field, the index of the value each
+    ///   point's surface came from, to a single level's output.
+    //
+    // Programmer:  Jeremy Meredith
+    // Creation:    October 18, 2026
+    //
+    // Modifications:
+    // ************************************************************************
+    void AddLevelField(eavlDataSet *ds, int level)
+    {
+        int npts = ds->GetNumPoints();
+        eavlFloatArray *arr = new eavlFloatArray("level", 1, npts);
+        float *vals = (float*)arr->GetHostArray();
+        std::fill(vals, vals + npts, float(level));
+        ds->AddField(new eavlField(1, arr, eavlField::ASSOC_POINTS));
+    }
+
+    // ************************************************************************
+    // Method:  IsosurfaceOperation::AddParts
+    //
+    // Purpose:
+    ///   Collect the fields, arrays, cell sets, and coordinate systems
+    ///   of a data set.
+    //
+    // Programmer:  Jeremy Meredith
+    // Creation:    October 18, 2026
+    //
+    // Modifications:
+    // ************************************************************************
+    static void AddParts(eavlDataSet *ds, std::set<void*> &parts)
+    {
+        for (int i=0; i<ds->GetNumFields(); ++i)
+        {
+            parts.insert(ds->GetField(i));
+            parts.insert(ds->GetField(i)->GetArray());
+        }
+        for (int i=0; i<ds->GetNumCellSets(); ++i)
+            parts.insert(ds->GetCellSet(i));
+        for (int i=0; i<ds->GetNumCoordinateSystems(); ++i)
+            parts.insert(ds->GetCoordinateSystem(i));
+    }
+
+    // ************************************************************************
+    // Method:  IsosurfaceOperation::FreeLevel
+    //
+    // Purpose:
+    ///   Free the output for one value (or a partly merged output),
+    ///   except for the parts in keep: those of the input, which the
+    ///   filter may pass through, and of the merged output.
+    //
+    // Arguments:
+    //   ds         the data set to free
+    //   keep       the parts which must not be freed
+    //
+    // Programmer:  Jeremy Meredith
+    // Creation:    October 18, 2026
+    //
+    // Modifications:
+    // ************************************************************************
+    static void FreeLevel(eavlDataSet *ds, const std::set<void*> &keep)
+    {
+        for (int i=0; i<ds->GetNumFields(); ++i)
+        {
+            eavlField *f = ds->GetField(i);
+            if (!keep.count(f->GetArray()))
+                delete f->GetArray();
+            if (!keep.count(f))
+                DeleteFieldShell(f);
+        }
+        for (int i=0; i<ds->GetNumCellSets(); ++i)
+        {
+            if (!keep.count(ds->GetCellSet(i)))
+                delete ds->GetCellSet(i);
+        }
+        for (int i=0; i<ds->GetNumCoordinateSystems(); ++i)
+        {
+            if (!keep.count(ds->GetCoordinateSystem(i)))
+                delete ds->GetCoordinateSystem(i);
+        }
+        DeleteDataSetShell(ds);
+    }
+
+    // ************************************************************************
+    // Method:  IsosurfaceOperation::MergeLevels
+    //
+    // Purpose:
+    ///   Combine the outputs for each value into one data set, appending
+    ///   their points, cells, and fields, and tagging the points with
+    ///   their level.  The outputs all come from the same filter, so they
+    ///   have the same fields, and their coordinates refer to those fields
+    ///   by name; we can keep the first one's coordinate system.  The
+    ///   caller frees the levels; if we fail, we free what we made.
+    //
+    // Arguments:
+    //   levels     the output for each value
+    //   keep       the parts of the input, which the levels may share
+    //
+    // Programmer:  Jeremy Meredith
+    // Creation:    October 18, 2026
+    //
+    // Modifications:
+    //   Jeremy Meredith, Mon Oct 19 01:53:21 EDT 2026
+    //   Check the levels match before making anything, and free the
+    //   partial output on failure instead of the levels.  Copy float
+    //   arrays directly, and use the cell's own index array.
+    //
+    // ************************************************************************
+    eavlDataSet *MergeLevels(std::vector<eavlDataSet*> &levels,
+                             const std::set<void*> &keep)
+    {
+        eavlDataSet *first = levels[0];
+        eavlCellSet *firstcs = first->GetCellSet(0);
+
+        // find each field of the first level in the others
+        std::vector< std::vector<eavlArray*> > sources(first->GetNumFields());
+        for (int f=0; f<first->GetNumFields(); ++f)
+        {
+            eavlArray *arr = first->GetField(f)->GetArray();
+            for (size_t l=0; l<levels.size(); ++l)
+            {
+                eavlArray *src = NULL;
+                for (int g=0; g<levels[l]->GetNumFields(); ++g)
+                {
+                    if (levels[l]->GetField(g)->GetArray()->GetName() ==
+                        arr->GetName())
+                        src = levels[l]->GetField(g)->GetArray();
+                }
+                if (!src || src->GetNumberOfComponents() !=
+                            arr->GetNumberOfComponents())
+                    throw eavlException("isosurface levels differ in fields");
+                sources[f].push_back(src);
+            }
+        }
+
+        int npts = 0;
+        for (size_t l=0; l<levels.size(); ++l)
+            npts += levels[l]->GetNumPoints();
+
+        eavlDataSet *out = new eavlDataSet;
+        try
+        {
+            out->SetNumPoints(npts);
+            out->AddCoordinateSystem(first->GetCoordinateSystem(0));
+
+            eavlExplicitConnectivity conn;
+            int offset = 0;
+            for (size_t l=0; l<levels.size(); ++l)
+            {
+                eavlCellSet *cs = levels[l]->GetCellSet(0);
+                for (int i=0; i<cs->GetNumCells(); ++i)
+                {
+                    // the cell's own index array is sized for any cell
+                    eavlCell cell = cs->GetCellNodes(i);
+                    for (int j=0; j<cell.numIndices; ++j)
+                        cell.indices[j] += offset;
+                    conn.AddElement(cell.type, cell.numIndices, cell.indices);
+                }
+                offset += levels[l]->GetNumPoints();
+            }
+            eavlCellSetExplicit *cells =
+                new eavlCellSetExplicit(firstcs->GetName(),
+                                        firstcs->GetDimensionality());
+            out->AddCellSet(cells);
+            cells->SetCellNodeConnectivity(conn);
+
+            for (int f=0; f<first->GetNumFields(); ++f)
+            {
+                eavlField *field = first->GetField(f);
+                bool nodal = field->GetAssociation() == eavlField::ASSOC_POINTS;
+                if (!nodal &&
+                    field->GetAssociation() != eavlField::ASSOC_CELL_SET)
+                {
+                    out->AddField(field);
+                    continue;
+                }
+
+                string name = field->GetArray()->GetName();
+                int nc = field->GetArray()->GetNumberOfComponents();
+                int n = nodal ? npts : cells->GetNumCells();
+                eavlFloatArray *arr = new eavlFloatArray(name, nc, n);
+                if (nodal)
+                    out->AddField(new eavlField(field->GetOrder(), arr,
+                                                eavlField::ASSOC_POINTS));
+                else
+                    out->AddField(new eavlField(field->GetOrder(), arr,
+                                                eavlField::ASSOC_CELL_SET,
+                                                cells->GetName()));
+
+                float *dst = (float*)arr->GetHostArray();
+                int start = 0;
+                for (size_t l=0; l<levels.size(); ++l)
+                {
+                    eavlArray *src = sources[f][l];
+                    int ntuples = src->GetNumberOfTuples();
+                    if (dynamic_cast<eavlFloatArray*>(src))
+                    {
+                        const float *vals = (const float*)src->GetHostArray();
+                        std::copy(vals, vals + ntuples*nc, dst + start*nc);
+                    }
+                    else
+                    {
+                        for (int i=0; i<ntuples; ++i)
+                            for (int c=0; c<nc; ++c)
+                                dst[(start+i)*nc + c] =
+                                    src->GetComponentAsDouble(i, c);
+                    }
+                    start += ntuples;
+                }
+            }
+
+            eavlFloatArray *level = new eavlFloatArray("level", 1, npts);
+            out->AddField(new eavlField(1, level, eavlField::ASSOC_POINTS));
+            float *lv = (float*)level->GetHostArray();
+            offset = 0;
+            for (size_t l=0; l<levels.size(); ++l)
+            {
+                std::fill(lv + offset, lv + offset + levels[l]->GetNumPoints(),
+                          float(l));
+                offset += levels[l]->GetNumPoints();
+            }
+        }
+        catch (...)
+        {
+            std::set<void*> shared(keep);
+            for (size_t l=0; l<levels.size(); ++l)
+                AddParts(levels[l], shared);
+            FreeLevel(out, shared);
+            throw;
+        }
+        return out;
     }
 };
 
@@ -6,6 +6,7 @@
 #include <QLineEdit>
 #include <QGridLayout>
 #include <QLabel>
+#include <QMutex>
 
 #include "STL.h"
 #include "Attribute.h"
@@ -15,31 +16,67 @@
 //
 // Purpose:
 ///   Base class for an Operation like isosurface or slice.
+///
+///   Some operations (e.g. Isosurface, Histogram) are filters which
+///   create a brand new output data set.  Others (e.g. Threshold,
+///   ExternalFace, SurfaceNormals) are mutators which add to their input
+///   and return it as their output.  The pipeline hands every operation
+///   its own shallow copy of the previous result, so adding new fields,
+///   cell sets, or coordinate systems is safe.  Changing one that already
+///   exists is not, since it is shared with the earlier (cached) results;
+///   an operation which does that must list it in GetModifiedParts(),
+///   and the pipeline will give it a private copy of just those parts.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    August 9, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 11:03:18 EDT 2026
+//   Added GetModifiedParts for copy-on-write inputs.
+//
+//   Jeremy Meredith, Sun Oct 18 13:40:02 EDT 2026
+//   Execute now takes its input and returns its output, and may be
+//   called from several threads at once (one per chunk).  Operations
+//   create their EAVL filters and mutators per call for this reason.
+//
+//   Jeremy Meredith, Sun Oct 18 23:52:18 EDT 2026
+//   Added CombinesChunks and ExecuteCombined.
+//
 // ****************************************************************************
+struct DataSetParts
+{
+    std::vector<std::string> fields;
+    std::vector<int>         coordinateSystems;
+    std::vector<std::string> cellSets;
+};
+
 class Operation
 {
-  protected:
-    eavlDataSet *input;
-    eavlDataSet *output;
   public:
-    Operation() : input(NULL), output(NULL) { }
+    Operation() { }
     /// Get the variables the operation is requesting.
     virtual std::vector<std::string> GetNeededVariables() { return std::vector<std::string>(); }
     /// Get the variables this operation creates.
     virtual std::vector<std::string> GetOutputVariables() { return std::vector<std::string>(); }
+    /// Get the existing parts of the given input which Execute will
+    /// change in place (as opposed to adding new ones).
+    virtual DataSetParts GetModifiedParts(eavlDataSet *) { return DataSetParts(); }
     /// Get the Attribute containing this operation's settings.
     virtual Attribute *GetSettings() = 0;
-    /// Actual execution method for an operation.
-    virtual void Execute() = 0;
-    /// Set the input data set.
-    void SetInput(eavlDataSet *ds) { input = ds; }
-    /// Get the output data set.  This is only safe after Execute().
-    eavlDataSet *GetOutput() { return output; }
+    /// Actual execution method for an operation.  This must be safe
+    /// to call for different inputs from different threads.
+    virtual eavlDataSet *Execute(eavlDataSet *input) = 0;
+    /// True if the operation needs every chunk's input at once, e.g. to
+    /// sum over all of them; the pipeline then calls ExecuteCombined.
+    virtual bool CombinesChunks() { return false; }
+    /// Execute for all chunks at once, returning one output per chunk.
+    virtual std::vector<eavlDataSet*> ExecuteCombined(const std::vector<eavlDataSet*> &inputs)
+    {
+        std::vector<eavlDataSet*> outputs;
+        for (size_t i=0; i<inputs.size(); ++i)
+            outputs.push_back(Execute(inputs[i]));
+        return outputs;
+    }
     /// Get the user-visible name for the operation.
     virtual std::string GetOperationName() = 0;
     /// Get a very concise name for the operation (3-5 characters).
@@ -48,4 +85,11 @@ class Operation
     virtual std::string GetOperationInfo() = 0;
 };
 
+/// The EAVL executor keeps its plan in static storage, so only one
+/// thread at a time may be running EAVL filters or mutators.  Hold it
+/// only around their Execute calls; setting them up, and anything else
+/// an operation does, can run alongside other chunks.  (The executor
+/// runs each plan across the cores itself.)
+extern QMutex eavlExecutorMutex;
+
 #endif
@@ -1,5 +1,1761 @@
 // Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
 #include "Pipeline.h"
+#include "ResultCache.h"
 
+#include "ExternalFaceOperation.h"
+#include "ElevateOperation.h"
+#include "IsosurfaceOperation.h"
+#include "HistogramOperation.h"
+#include "SurfaceNormalsOperation.h"
+#include "ThresholdOperation.h"
+#include "TransformOperation.h"
+
+#include <eavlImporterFactory.h>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <fstream>
 
 vector<Pipeline*> Pipeline::allPipelines;
+
+QMutex eavlExecutorMutex;
+
+// ****************************************************************************
+// Function:  GetImporterMutex
+//
+// Purpose:
+///   Importers keep file handles and caches of their own and aren't
+///   generally safe to call from more than one thread, so each one gets
+///   a lock.  Different files can be read at the same time.
+//
+// Arguments:
+//   importer   the importer
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static QMutex *
+GetImporterMutex(eavlImporter *importer)
+{
+    static QMutex mapLock;
+    static std::map<eavlImporter*, QMutex*> importerMutexes;
+
+    QMutexLocker lock(&mapLock);
+    QMutex *&m = importerMutexes[importer];
+    if (!m)
+        m = new QMutex;
+    return m;
+}
+
+// ****************************************************************************
+// Struct:  ChunkExecutor
+//
+// Purpose:
+///   Function object for running one chunk of a pipeline from a
+///   QtConcurrent map.  Exceptions can't cross out of the worker threads,
+///   so the first error message is saved for Execute to throw.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 23:52:18 EDT 2026
+//   Added the stage to stop at.
+//
+//   Jeremy Meredith, Mon Oct 19 01:26:44 EDT 2026
+//   Catch anything else, too; it would take down the whole program.
+//
+// ****************************************************************************
+struct ChunkExecutor
+{
+    typedef void result_type;
+
+    Pipeline                       *pipe;
+    const std::vector<std::string> *vars;
+    const std::vector<std::string> *keys;
+    int                             endStage;
+    ExecutionMonitor               *monitor;
+    QMutex                         *errorLock;
+    std::string                    *error;
+
+    void operator()(int &chunk)
+    {
+        try
+        {
+            pipe->ExecuteChunk(chunk, *vars, *keys, endStage, monitor);
+        }
+        catch (const eavlException &e)
+        {
+            QMutexLocker lock(errorLock);
+            if (error->empty())
+                *error = e.GetErrorText();
+        }
+        catch (...)
+        {
+            QMutexLocker lock(errorLock);
+            if (error->empty())
+                *error = "unexpected error executing a chunk";
+        }
+    }
+};
+
+// ****************************************************************************
+// Function:  GetFieldInfo
+//
+// Purpose:
+///   Describe one field for GetVariables.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static FieldInfo
+GetFieldInfo(eavlField *f)
+{
+    FieldInfo finfo;
+    finfo.name = f->GetArray()->GetName();
+    finfo.ncomp = f->GetArray()->GetNumberOfComponents();
+    return finfo;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetVariables
+//
+// Purpose:
+///   Describe the fields and cell sets in the pipeline's published
+///   output.  The structure comes from the first chunk.
+//
+// Arguments:
+//   index      (unused)
+//
+// Programmer:  Jeremy Meredith
+// Creation:    August 3, 2012
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 13:40:02 EDT 2026
+//   Moved from the header, and take ranges over all chunks.
+//
+//   Jeremy Meredith, Sun Oct 18 15:02:37 EDT 2026
+//   Don't execute; execution happens in the background now, and
+//   this is only called once there's output.
+//
+//   Jeremy Meredith, Sun Oct 18 21:17:52 EDT 2026
+//   Don't compute the field ranges; see GetFieldStats.
+//
+// ****************************************************************************
+DSInfo
+Pipeline::GetVariables(int /*index*/)
+{
+    DSInfo dsinfo;
+    if (output.size() == 0)
+        return dsinfo;
+
+    eavlDataSet *ds = output[0];
+    for (int j=0; j<ds->GetNumFields(); ++j)
+    {
+        eavlField *f = ds->GetField(j);
+        if (f->GetAssociation() == eavlField::ASSOC_POINTS)
+        {
+            dsinfo.nodalfields.push_back(GetFieldInfo(f));
+        }
+    }
+
+
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+    {
+        eavlCellSet *cs = ds->GetCellSet(i);
+        CellSetInfo csinfo;
+        csinfo.name = cs->GetName();
+        csinfo.topodim = cs->GetDimensionality();
+        dsinfo.cellsets.push_back(csinfo);
+        for (int j=0; j<ds->GetNumFields(); ++j)
+        {
+            eavlField *f = ds->GetField(j);
+            if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                f->GetAssocCellSet() == cs->GetName())
+            {
+                dsinfo.cellsetfields[cs->GetName()].push_back(GetFieldInfo(f));
+            }
+        }
+    }
+
+    // list the fields we could read but haven't yet; we don't know
+    // their centering or size until someone asks for them
+    dsinfo.unloadedfields = GetUnloadedVariables();
+
+    //cerr << ">> GetVariables <<\n"; dsinfo.Print(cerr);
+    return dsinfo;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetFieldStats
+//
+// Purpose:
+///   Get the value ranges of a field in the published output, over
+///   every chunk which has it.  Each array's stats are computed once
+///   and then cached (see FieldStatsCache), so this is cheap to call
+///   again for the same output.
+//
+// Arguments:
+//   name       the field name
+//   stage      a stage of the results to use instead of the output,
+//              e.g. an operation's index for its input; chunks which
+//              haven't been computed are skipped
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   Added the stage argument.
+//
+// ****************************************************************************
+FieldStats
+Pipeline::GetFieldStats(const std::string &name, int stage)
+{
+    std::vector<eavlDataSet*> empty;
+    std::vector<eavlDataSet*> &dss = (stage < 0) ? output :
+                         (stage < (int)results.size()) ? results[stage] : empty;
+
+    FieldStats stats;
+    for (size_t c=0; c<dss.size(); ++c)
+    {
+        eavlDataSet *ds = dss[c];
+        if (!ds)
+            continue;
+        for (int j=0; j<ds->GetNumFields(); ++j)
+        {
+            eavlArray *arr = ds->GetField(j)->GetArray();
+            if (arr->GetName() == name)
+                stats.Merge(FieldStatsCache::Get(arr));
+        }
+    }
+    return stats;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetNeededVariables
+//
+// Purpose:
+///   Get the variables that must be read from the source to satisfy
+///   the operations and any consumer requests.  We walk the operations
+///   backwards: a variable created by an operation doesn't need to be
+///   read by anything upstream of it.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:04:36 EDT 2026
+//   For a pipe source, we ask the source pipeline for all of them.
+//
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Support the geometry source.
+//
+// ****************************************************************************
+std::vector<std::string>
+Pipeline::GetNeededVariables()
+{
+    std::set<std::string> needed(requestedVars);
+    for (int i=int(ops.size())-1; i>=0; --i)
+    {
+        std::vector<std::string> outvars = ops[i]->GetOutputVariables();
+        for (size_t j=0; j<outvars.size(); j++)
+            needed.erase(outvars[j]);
+        std::vector<std::string> invars = ops[i]->GetNeededVariables();
+        needed.insert(invars.begin(), invars.end());
+    }
+
+    // only keep ones the source can actually provide
+    std::vector<std::string> vars;
+    if (source->sourcetype == Source::Pipe)
+        return std::vector<std::string>(needed.begin(), needed.end());
+    std::vector<std::string> avail = source->GetFieldList();
+    for (size_t i=0; i<avail.size(); i++)
+    {
+        if (needed.count(avail[i]))
+            vars.push_back(avail[i]);
+    }
+    return vars;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetUnloadedVariables
+//
+// Purpose:
+///   Get the variables the source provides that we haven't read.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Support the geometry source.
+//
+// ****************************************************************************
+std::vector<std::string>
+Pipeline::GetUnloadedVariables()
+{
+    std::vector<std::string> vars;
+    std::vector<std::string> avail = source->GetFieldList();
+    for (size_t i=0; i<avail.size(); i++)
+    {
+        if (results.size() == 0 || !results[0][0] ||
+            !HasField(results[0][0], avail[i]))
+        {
+            vars.push_back(avail[i]);
+        }
+    }
+    return vars;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::RequestVariable
+//
+// Purpose:
+///   Ask that a variable be available in the output.  Returns true
+///   if we don't have it at all, meaning the caller needs to Execute()
+///   again to get it; until then, NeedsExecute says so too.
+//
+// Arguments:
+//   name       the variable name
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:26:44 EDT 2026
+//   Remember that we need to read it.
+//
+// ****************************************************************************
+bool
+Pipeline::RequestVariable(const std::string &name)
+{
+    if (name.empty())
+        return false;
+    requestedVars.insert(name);
+    if (output.size() > 0 && HasField(output[0], name))
+        return false;
+    if (results.size() > 0 && results[0][0] &&
+        HasField(results[0][0], name))
+        return false;
+    readPending = true;
+    return true;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::SetRequestedVariables
+//
+// Purpose:
+///   Replace the variables consumers have asked for.  Returns true if
+///   one of them needs reading, like RequestVariable.  One we no longer
+///   want stays in the results until we next execute, which then reads
+///   without it.
+//
+// Arguments:
+//   names      the variable names
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+bool
+Pipeline::SetRequestedVariables(const std::set<std::string> &names)
+{
+    requestedVars.clear();
+    bool missing = false;
+    for (std::set<std::string>::const_iterator it = names.begin();
+         it != names.end(); ++it)
+    {
+        if (RequestVariable(*it))
+            missing = true;
+    }
+    return missing;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::UpdateRequestedVariables
+//
+// Purpose:
+///   Rebuild what every pipeline is asked for from its current
+///   consumers: the variables its plots show, and whatever its branches
+///   need from it.  Since the variables read are part of the stage keys,
+///   this keeps pipelines that do the same work sharing their results,
+///   whatever was plotted before.  A busy pipeline is left alone (and
+///   its branches with it); it gets asked again when it's done.
+///   Returns true if anything needs reading.
+//
+// Arguments:
+//   plotted    the variables plotted from each pipeline
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+bool
+Pipeline::UpdateRequestedVariables(
+    const std::map<Pipeline*, std::set<std::string> > &plotted)
+{
+    // a branch's needs depend on its own requests, so work from the
+    // ends of the chains of pipe sources back to their roots
+    std::vector< std::pair<int,Pipeline*> > order;
+    for (size_t i=0; i<allPipelines.size(); i++)
+    {
+        Pipeline *p = allPipelines[i];
+        int depth = 0;
+        for (Pipeline *up = p;
+             up->source->sourcetype == Source::Pipe && up->source->source_pipe &&
+             depth < int(allPipelines.size());
+             up = up->source->source_pipe)
+        {
+            ++depth;
+        }
+        order.push_back(std::make_pair(-depth, p));
+    }
+    std::sort(order.begin(), order.end());
+
+    std::map<Pipeline*, std::set<std::string> > wanted(plotted);
+    bool missing = false;
+    for (size_t i=0; i<order.size(); i++)
+    {
+        Pipeline *p = order[i].second;
+        if (p->IsBusy())
+            continue;
+        if (p->SetRequestedVariables(wanted[p]))
+            missing = true;
+        if (p->source->sourcetype == Source::Pipe && p->source->source_pipe)
+        {
+            std::vector<std::string> vars = p->GetNeededVariables();
+            wanted[p->source->source_pipe].insert(vars.begin(), vars.end());
+        }
+    }
+    return missing;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetStageKeys
+//
+// Purpose:
+///   Get the ResultCache key for each stage of the results.  A stage's
+///   key describes everything that went into it: the source, the
+///   variables read, and the type and settings of each operation up to
+///   that point.  So any pipelines with the same key for a stage can
+///   share that stage's results.
+//
+// Arguments:
+//   vars       the variables read from the source
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:04:36 EDT 2026
+//   A pipe source's key is the key of the source pipeline's stage, so
+//   we share its results without adding them to the cache again.
+//
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Key a geometry source by what it generates.
+//
+//   Jeremy Meredith, Mon Oct 19 02:04:15 EDT 2026
+//   Leave out transforms applied at render time; they don't change
+//   the data, so their stage has the same key as their input.
+//
+// ****************************************************************************
+std::vector<std::string>
+Pipeline::GetStageKeys(const std::vector<std::string> &vars)
+{
+    std::vector<std::string> keys;
+    std::string key;
+    if (source->sourcetype == Source::Pipe && source->source_pipe)
+    {
+        Pipeline *up = source->source_pipe;
+        key = up->GetStageKeys(up->GetNeededVariables())[GetSourcePipeStage()];
+    }
+    else
+    {
+        if (source->sourcetype == Source::Geometry)
+            key = GeometrySource::GetKey(*source->geometry);
+        else
+            key = "File:" + source->file + ":" + source->mesh + ":";
+        for (size_t i=0; i<vars.size(); i++)
+            key += vars[i] + ",";
+    }
+    keys.push_back(key);
+
+    for (size_t i=0; i<ops.size(); i++)
+    {
+        TransformOperation *xform = dynamic_cast<TransformOperation*>(ops[i]);
+        if (!xform || !xform->AppliesAtRenderTime())
+        {
+            key += "|" + ops[i]->GetOperationName();
+            Attribute *atts = ops[i]->GetSettings();
+            if (atts)
+                key += atts->XMLSerialize();
+        }
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::Execute
+//
+// Purpose:
+///   Bring every result up to date.  Each chunk of the source runs
+///   through the operations independently, so the chunks are spread
+///   across the global thread pool.  Anything already computed is kept,
+///   and anything another pipeline computed the same way is reused (see
+///   ResultCache).  This doesn't change the output; call Publish for that.
+//
+// Arguments:
+//   monitor    optional progress and cancellation callbacks
+//   lastStage  the stage to bring up to date, if not the final one
+//
+// Programmer:  Jeremy Meredith
+// Creation:    August 3, 2012
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 13:40:02 EDT 2026
+//   Moved from the header.  Read and execute all chunks, in parallel.
+//
+//   Jeremy Meredith, Sun Oct 18 15:02:37 EDT 2026
+//   Added the monitor.
+//
+//   Jeremy Meredith, Sun Oct 18 16:21:09 EDT 2026
+//   Share results through the ResultCache.
+//
+//   Jeremy Meredith, Sun Oct 18 17:45:50 EDT 2026
+//   Results may have holes where the cache evicted something; keep
+//   partial results after an error or cancellation.
+//
+//   Jeremy Meredith, Sun Oct 18 19:10:26 EDT 2026
+//   Record profiling stats.
+//
+//   Jeremy Meredith, Sun Oct 18 23:52:18 EDT 2026
+//   Run operations which combine the chunks on all of them at once.
+//
+//   Jeremy Meredith, Mon Oct 19 00:04:36 EDT 2026
+//   Start from the source pipeline's result for a pipe source.  Added
+//   lastStage, for when we're someone else's pipe source.
+//
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Support the geometry source.
+//
+//   Jeremy Meredith, Mon Oct 19 01:26:44 EDT 2026
+//   Catch any error from a combining operation.  Clear readPending.
+//
+// ****************************************************************************
+void
+Pipeline::Execute(ExecutionMonitor *monitor, int lastStage)
+{
+    //cerr << "\n\n>>>>EXECUTE\n\n\n";
+
+    int endStage = ops.size();
+    if (lastStage >= 0 && lastStage < endStage)
+        endStage = lastStage;
+
+    // new geometry settings mean a new mesh
+    if (source->sourcetype == Source::Geometry && source->UpdateGeometry())
+        ClearResults();
+
+    // a pipe source brings its own pipeline up to date and hands us its
+    // results; otherwise, if an operator or a plot now wants a variable
+    // we haven't read, anything computed from the old initial data set
+    // is stale
+    std::vector<std::string> vars = GetNeededVariables();
+    readPending = false;
+    if (source->sourcetype == Source::Pipe)
+        PullFromSourcePipe(monitor);
+    else if (results.size() > 0)
+    {
+        for (size_t c=0; c<results[0].size(); c++)
+        {
+            if (!results[0][c])
+                continue;
+            for (size_t i=0; i<vars.size(); i++)
+            {
+                if (!HasField(results[0][c], vars[i]))
+                {
+                    InvalidateResults(0);
+                    break;
+                }
+            }
+        }
+    }
+
+    if (results.size() == 0)
+    {
+        eavlImporter *importer = source->GetImporter();
+        if (!importer)
+            throw eavlException("no source file selected");
+
+        int nchunks = importer->GetNumChunks(source->GetMeshName());
+        if (nchunks <= 0)
+            throw eavlException("mesh has no chunks");
+
+        results.push_back(std::vector<eavlDataSet*>(nchunks, (eavlDataSet*)NULL));
+    }
+
+    // make room for everything; ExecuteChunk fills in whatever's missing
+    int nchunks = results[0].size();
+    results.resize(ops.size()+1,
+                   std::vector<eavlDataSet*>(nchunks, (eavlDataSet*)NULL));
+
+    // stats are only for what this execution does
+    stats.clear();
+    stats.resize(ops.size()+1, std::vector<StageStats>(nchunks));
+    double starttime = StageTimer::GetWallTime();
+
+    if (monitor)
+    {
+        // roughly; some of these may come from the cache
+        int npieces = 0;
+        for (int c=0; c<nchunks; ++c)
+            for (int i=endStage; i>=0 && !results[i][c]; --i)
+                ++npieces;
+        monitor->Begin(npieces);
+    }
+
+    std::vector<int> chunks;
+    for (int c=0; c<nchunks; ++c)
+        chunks.push_back(c);
+
+    std::vector<std::string> keys = GetStageKeys(vars);
+    resultKeys = keys;
+
+    // an operation which combines the chunks needs all of their inputs
+    // at once, so we run the chunks in parallel up to each of those
+    // which has to run, run it, and go on from its output
+    std::vector<int> combined = GetCombinedStages(keys, endStage, monitor);
+
+    QMutex errorLock;
+    std::string error;
+    ChunkExecutor executor;
+    executor.pipe = this;
+    executor.vars = &vars;
+    executor.keys = &keys;
+    executor.monitor = monitor;
+    executor.errorLock = &errorLock;
+    executor.error = &error;
+    for (size_t s=0; s<=combined.size(); ++s)
+    {
+        executor.endStage = (s < combined.size()) ? combined[s] : endStage;
+        QtConcurrent::blockingMap(chunks, executor);
+        if (!error.empty() || s == combined.size())
+            break;
+        std::vector<eavlDataSet*> &inputs = results[executor.endStage];
+        if (std::find(inputs.begin(), inputs.end(),
+                      (eavlDataSet*)NULL) != inputs.end())
+            break;
+        try
+        {
+            ExecuteCombinedStage(combined[s], keys, monitor);
+        }
+        catch (const eavlException &e)
+        {
+            error = e.GetErrorText();
+        }
+        catch (...)
+        {
+            error = "unexpected error executing " +
+                    ops[combined[s]]->GetOperationName();
+        }
+    }
+    executeTime = StageTimer::GetWallTime() - starttime;
+
+    // whatever did finish is fine to keep for next time
+    if (!error.empty())
+        throw eavlException(error);
+    if (std::find(results[endStage].begin(), results[endStage].end(),
+                  (eavlDataSet*)NULL) != results[endStage].end())
+        throw eavlException("execution was cancelled");
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetBranches
+//
+// Purpose:
+///   The pipelines which take their input directly from one of our
+///   stages (i.e. have a pipe source on us), in the order they were made.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::vector<Pipeline*>
+Pipeline::GetBranches()
+{
+    std::vector<Pipeline*> branches;
+    for (size_t i=0; i<allPipelines.size(); ++i)
+    {
+        Source *s = allPipelines[i]->source;
+        if (s && s->sourcetype == Source::Pipe && s->source_pipe == this)
+            branches.push_back(allPipelines[i]);
+    }
+    return branches;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetDownstream
+//
+// Purpose:
+///   Every pipeline which takes its input from us, directly or through
+///   other branches.  Each one comes after the one it takes its input
+///   from, so executing them in order executes every stage once: each
+///   branch finds everything upstream of it already up to date.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::vector<Pipeline*>
+Pipeline::GetDownstream()
+{
+    std::vector<Pipeline*> downstream = GetBranches();
+    for (size_t i=0; i<downstream.size(); ++i)
+    {
+        std::vector<Pipeline*> more = downstream[i]->GetBranches();
+        downstream.insert(downstream.end(), more.begin(), more.end());
+    }
+    return downstream;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::CreateBranch
+//
+// Purpose:
+///   Create a new pipeline, with no operations yet, which takes its
+///   input from one of our stages, and add it to allPipelines.
+//
+// Arguments:
+//   stage      0 for what we read, i for the output of ops[i-1], or -1
+//              for our final result (whatever our operations become)
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+Pipeline *
+Pipeline::CreateBranch(int stage)
+{
+    Pipeline *branch = new Pipeline;
+    branch->source->sourcetype = Source::Pipe;
+    branch->source->source_pipe = this;
+    branch->source->source_stage = stage;
+    allPipelines.push_back(branch);
+    return branch;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetDemandedStage
+//
+// Purpose:
+///   The last stage anyone needs from us: our final result if we're
+///   viewed, else the furthest stage a demanded branch starts from.
+///   Returns -1 if nobody needs anything, in which case we stay dormant
+///   until someone does.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+int
+Pipeline::GetDemandedStage()
+{
+    if (viewed)
+        return ops.size();
+
+    int stage = -1;
+    std::vector<Pipeline*> branches = GetBranches();
+    for (size_t i=0; i<branches.size(); ++i)
+    {
+        if (branches[i]->GetDemandedStage() >= 0)
+            stage = std::max(stage, branches[i]->GetSourcePipeStage());
+    }
+    return stage;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::TrimCache
+//
+// Purpose:
+///   Bring the ResultCache back under its memory budget.  The published
+///   output of every pipeline is pinned, since windows are drawing it;
+///   anything else may be evicted and will be recomputed if needed.
+///   Evicted results become holes in the pipelines' results.
+///   This must be called from the GUI thread, and does nothing while
+///   any pipeline is executing, since it may be using anything.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Pipeline::TrimCache()
+{
+    std::set<eavlDataSet*> pinned;
+    for (size_t p=0; p<allPipelines.size(); ++p)
+    {
+        if (allPipelines[p]->executing)
+            return;
+        pinned.insert(allPipelines[p]->output.begin(),
+                      allPipelines[p]->output.end());
+    }
+
+    std::set<eavlDataSet*> evicted = ResultCache::Trim(pinned);
+    if (evicted.empty())
+        return;
+
+    for (size_t p=0; p<allPipelines.size(); ++p)
+    {
+        std::vector< std::vector<eavlDataSet*> > &r = allPipelines[p]->results;
+        for (size_t i=0; i<r.size(); ++i)
+            for (size_t c=0; c<r[i].size(); ++c)
+                if (evicted.count(r[i][c]))
+                    r[i][c] = NULL;
+    }
+}
+
+// ****************************************************************************
+// Method:  Pipeline::ExecuteChunk
+//
+// Purpose:
+///   Bring the results for one chunk up to date, reading it first if
+///   needed.  This is called from worker threads; it only touches its
+///   own chunk's entries in the results, which Execute has already
+///   allocated.  If cancelled, it returns early, leaving some of them
+///   empty.  Each result is looked up in the ResultCache before we
+///   compute it, and added to it after.
+//
+// Arguments:
+//   chunk      the chunk index
+//   vars       the variables to read from the source
+//   keys       the ResultCache key for each stage
+//   endStage   the last stage to bring up to date
+//   monitor    optional progress and cancellation callbacks
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 15:02:37 EDT 2026
+//   Added the monitor.  Don't add fields to an existing initial data
+//   set, since it may be published output someone is drawing.
+//
+//   Jeremy Meredith, Sun Oct 18 16:21:09 EDT 2026
+//   Use the ResultCache.
+//
+//   Jeremy Meredith, Sun Oct 18 17:45:50 EDT 2026
+//   Start from the latest stage we have, so an evicted intermediate
+//   result is only recomputed if something after it is needed.
+//
+//   Jeremy Meredith, Sun Oct 18 19:10:26 EDT 2026
+//   Record profiling stats.  An operation's time includes making its
+//   copy-on-write input.
+//
+//   Jeremy Meredith, Sun Oct 18 23:41:27 EDT 2026
+//   Fold runs of coordinate transforms into one rewrite.
+//
+//   Jeremy Meredith, Sun Oct 18 23:52:18 EDT 2026
+//   Stop at a given stage, so Execute can run an operation which
+//   combines the chunks.  Moved the cache lookup to FindResult.
+//
+//   Jeremy Meredith, Mon Oct 19 00:04:36 EDT 2026
+//   Don't read anything for a pipe source.
+//
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Generate chunks of a geometry source without the importer lock,
+//   and let the ResultCache own them.
+//
+//   Jeremy Meredith, Mon Oct 19 01:22:08 EDT 2026
+//   Lock each importer separately, and only while calling it.  Free an
+//   operation's input when it returns a new data set.
+//
+// ****************************************************************************
+void
+Pipeline::ExecuteChunk(int chunk, const std::vector<std::string> &vars,
+                       const std::vector<std::string> &keys,
+                       int endStage, ExecutionMonitor *monitor)
+{
+    if (monitor && monitor->Cancelled())
+        return;
+
+    // find the latest stage we have, or someone else has computed; the
+    // result of a transform folded into the next one only carries its
+    // matrix, so we go back to the input of the whole run instead
+    int nstages = endStage+1;
+    int start = endStage;
+    while (start >= 0)
+    {
+        if (!(start > 0 && FoldsIntoNext(start-1)) &&
+            FindResult(start, chunk, keys, monitor))
+            break;
+        --start;
+    }
+
+    // read the mesh; a pipe source's results are all there already
+    StageTimer readTimer;
+    bool fresh = false;
+    if (start < 0 && source->sourcetype == Source::Pipe)
+        throw eavlException("source pipeline has no result");
+    // file importers aren't thread safe, but the generator is, and what
+    // it makes is ours, so the cache can evict and free it
+    eavlImporter *importer = source->GetImporter();
+    bool generated = (source->sourcetype == Source::Geometry);
+    QMutex *importerLock = generated ? NULL : GetImporterMutex(importer);
+    if (start < 0)
+    {
+        eavlDataSet *ds;
+        {
+            QMutexLocker lock(importerLock);
+            ds = importer->GetMesh(source->GetMeshName(), chunk);
+        }
+        results[0][chunk] = generated ? ds : ds->CreateShallowCopy();
+        fresh = true;
+        start = 0;
+    }
+
+    // read the variables we need but don't have yet; Execute has thrown
+    // away anything computed without them
+    if (start == 0 && source->sourcetype != Source::Pipe)
+    {
+        for (size_t i=0; i<vars.size(); i++)
+        {
+            if (HasField(results[0][chunk], vars[i]))
+                continue;
+            if (!fresh)
+            {
+                results[0][chunk] = results[0][chunk]->CreateShallowCopy();
+                fresh = true;
+            }
+            eavlField *f;
+            {
+                QMutexLocker lock(importerLock);
+                f = importer->GetField(vars[i], source->GetMeshName(), chunk);
+            }
+            results[0][chunk]->AddField(f);
+        }
+        if (fresh)
+        {
+            readTimer.Stop(stats[0][chunk]);
+            stats[0][chunk].SetOutput(results[0][chunk]);
+
+            // what we read belongs to the importer; see ResultCache
+            results[0][chunk] = ResultCache::Add(keys[0], chunk,
+                                                 results[0][chunk], !generated);
+            if (monitor)
+                monitor->PieceFinished(0, chunk);
+        }
+    }
+
+    for (int i=start; i<nstages-1; ++i)
+    {
+        if (monitor && monitor->Cancelled())
+            return;
+
+        if (FoldsIntoNext(i))
+        {
+            i = ExecuteFoldedTransforms(i, chunk, keys, monitor);
+            continue;
+        }
+
+        // give each operation its own data set structure, sharing
+        // everything with our earlier result except the parts it
+        // says it will change (see Operation)
+        StageTimer timer;
+        eavlDataSet *in = results[i][chunk];
+        stats[i+1][chunk].SetInput(in);
+        eavlDataSet *cow = CreateCopyOnWriteInput(in,
+                                                  ops[i]->GetModifiedParts(in));
+        eavlDataSet *ds;
+        try
+        {
+            ds = ops[i]->Execute(cow);
+        }
+        catch (...)
+        {
+            FreeCopyOnWriteInput(in, cow, NULL);
+            throw;
+        }
+        FreeCopyOnWriteInput(in, cow, ds);
+        timer.Stop(stats[i+1][chunk]);
+        stats[i+1][chunk].SetOutput(ds);
+
+        results[i+1][chunk] = ResultCache::Add(keys[i+1], chunk, ds, false);
+        if (monitor)
+            monitor->PieceFinished(i+1, chunk);
+    }
+}
+
+// ****************************************************************************
+// Struct:  SourcePipeMonitor
+//
+// Purpose:
+///   Passes cancellation through to a source pipeline's execution.  Its
+///   progress is in terms of its own stages, so we don't pass that on.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct SourcePipeMonitor : public ExecutionMonitor
+{
+    ExecutionMonitor *monitor;
+
+    SourcePipeMonitor(ExecutionMonitor *m) : monitor(m) { }
+    virtual bool Cancelled() { return monitor && monitor->Cancelled(); }
+};
+
+// ****************************************************************************
+// Method:  Pipeline::GetSourcePipeStage
+//
+// Purpose:
+///   The stage of the source pipeline we start from.  If it's lost the
+///   operations after the chosen stage, we use its final result.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+int
+Pipeline::GetSourcePipeStage()
+{
+    int nops = source->source_pipe->ops.size();
+    if (source->source_stage < 0 || source->source_stage > nops)
+        return nops;
+    return source->source_stage;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::RequestSourceVariables
+//
+// Purpose:
+///   Ask our source pipeline for whatever our operations and consumers
+///   need.  Asking before it executes saves it reading them later.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Pipeline::RequestSourceVariables()
+{
+    if (source->sourcetype != Source::Pipe || !source->source_pipe)
+        return;
+    std::vector<std::string> vars = GetNeededVariables();
+    source->source_pipe->requestedVars.insert(vars.begin(), vars.end());
+}
+
+// ****************************************************************************
+// Method:  Pipeline::PullFromSourcePipe
+//
+// Purpose:
+///   Bring the source pipeline up to date through the stage we start
+///   from, which only does any work if it's stale, and use its results
+///   for that stage as our initial data sets.  These are the same data
+///   sets, not copies; like any earlier result, nobody changes them
+///   (see CreateCopyOnWriteInput).  If they aren't the ones we had,
+///   everything we computed from the old ones is stale.
+//
+// Arguments:
+//   monitor    optional progress and cancellation callbacks
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Pipeline::PullFromSourcePipe(ExecutionMonitor *monitor)
+{
+    Pipeline *up = source->source_pipe;
+    if (!up)
+        throw eavlException("no source pipeline selected");
+    if (up->DependsOn(this))
+        throw eavlException("source pipeline depends on this one");
+
+    RequestSourceVariables();
+
+    int stage = GetSourcePipeStage();
+    SourcePipeMonitor upmonitor(monitor);
+    up->Execute(&upmonitor, stage);
+
+    const std::vector<eavlDataSet*> &upresults = up->results[stage];
+    bool same = (results.size() > 0 && results[0].size() == upresults.size());
+    for (size_t c=0; same && c<upresults.size(); ++c)
+    {
+        // a hole is something the cache evicted, which we can refill
+        if (results[0][c] && results[0][c] != upresults[c])
+            same = false;
+    }
+    if (!same)
+        ClearResults();
+    if (results.size() == 0)
+        results.push_back(upresults);
+    else
+        results[0] = upresults;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::FindResult
+//
+// Purpose:
+///   True if we have the result of a stage for a chunk, looking in the
+///   ResultCache for it if we don't yet.
+//
+// Arguments:
+//   stage      the stage
+//   chunk      the chunk index
+//   keys       the ResultCache key for each stage
+//   monitor    optional progress and cancellation callbacks
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+bool
+Pipeline::FindResult(int stage, int chunk, const std::vector<std::string> &keys,
+                     ExecutionMonitor *monitor)
+{
+    if (results[stage][chunk])
+        return true;
+    results[stage][chunk] = ResultCache::Find(keys[stage], chunk);
+    if (!results[stage][chunk])
+        return false;
+    stats[stage][chunk].SetOutput(results[stage][chunk]);
+    stats[stage][chunk].cached = 1;
+    stats[stage][chunk].nchunks = 1;
+    if (monitor)
+        monitor->PieceFinished(stage, chunk);
+    return true;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetCombinedStages
+//
+// Purpose:
+///   Find the operations which combine the chunks and have to run, in
+///   order.  One has to run if some chunk has no result after it to
+///   start from, and then every chunk needs its input; so going
+///   backwards, once one doesn't have to run, none before it do.
+//
+// Arguments:
+//   keys       the ResultCache key for each stage
+//   endStage   the last stage we're bringing up to date
+//   monitor    optional progress and cancellation callbacks
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::vector<int>
+Pipeline::GetCombinedStages(const std::vector<std::string> &keys,
+                            int endStage, ExecutionMonitor *monitor)
+{
+    std::vector<int> combined;
+    int limit = endStage;
+    int nchunks = GetNumChunks();
+    for (int c=endStage-1; c>=0; --c)
+    {
+        if (!ops[c]->CombinesChunks())
+            continue;
+
+        bool needed = false;
+        for (int chunk=0; chunk<nchunks && !needed; ++chunk)
+        {
+            bool found = false;
+            for (int s=limit; s>c && !found; --s)
+            {
+                if (!FoldsIntoNext(s-1))
+                    found = FindResult(s, chunk, keys, monitor);
+            }
+            needed = !found;
+        }
+        if (!needed)
+            break;
+        combined.insert(combined.begin(), c);
+        limit = c;
+    }
+    return combined;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::ExecuteCombinedStage
+//
+// Purpose:
+///   Run an operation which combines the chunks on all of them.  Its
+///   inputs must all be up to date.
+//
+// Arguments:
+//   opindex    the index of the operation
+//   keys       the ResultCache key for each stage
+//   monitor    optional progress and cancellation callbacks
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:22:08 EDT 2026
+//   Free the inputs the operation didn't return.
+//
+//   Jeremy Meredith, Mon Oct 19 02:55:03 EDT 2026
+//   Free the inputs and outputs when it returns the wrong number.
+//
+// ****************************************************************************
+void
+Pipeline::ExecuteCombinedStage(int opindex,
+                               const std::vector<std::string> &keys,
+                               ExecutionMonitor *monitor)
+{
+    if (monitor && monitor->Cancelled())
+        return;
+
+    int nchunks = GetNumChunks();
+    StageTimer timer;
+    std::vector<eavlDataSet*> inputs;
+    for (int c=0; c<nchunks; ++c)
+    {
+        eavlDataSet *ds = results[opindex][c];
+        stats[opindex+1][c].SetInput(ds);
+        inputs.push_back(CreateCopyOnWriteInput(ds,
+                                      ops[opindex]->GetModifiedParts(ds)));
+    }
+
+    std::vector<eavlDataSet*> outputs;
+    try
+    {
+        outputs = ops[opindex]->ExecuteCombined(inputs);
+    }
+    catch (...)
+    {
+        for (int c=0; c<nchunks; ++c)
+            FreeCopyOnWriteInput(results[opindex][c], inputs[c], NULL);
+        throw;
+    }
+    if ((int)outputs.size() != nchunks)
+    {
+        // none of it is cached; keep only what it shares with our
+        // earlier results
+        std::vector<eavlDataSet*> made(inputs);
+        made.insert(made.end(), outputs.begin(), outputs.end());
+        FreeUnkeptDataSets(made, results[opindex]);
+        throw eavlException("operation returned the wrong number of chunks");
+    }
+    for (int c=0; c<nchunks; ++c)
+        FreeCopyOnWriteInput(results[opindex][c], inputs[c], outputs[c]);
+
+    // the time is for all chunks together, so it goes on the first
+    timer.Stop(stats[opindex+1][0]);
+    for (int c=0; c<nchunks; ++c)
+    {
+        stats[opindex+1][c].computed = 1;
+        stats[opindex+1][c].nchunks = 1;
+        stats[opindex+1][c].SetOutput(outputs[c]);
+        results[opindex+1][c] = ResultCache::Add(keys[opindex+1], c,
+                                                 outputs[c], false);
+        if (monitor)
+            monitor->PieceFinished(opindex+1, c);
+    }
+}
+
+// ****************************************************************************
+// Method:  Pipeline::FoldsIntoNext
+//
+// Purpose:
+///   True if ops[opindex] and the operation after it both rewrite the
+///   same coordinate data with a matrix, so the two can be applied as
+///   one composed matrix (see ExecuteFoldedTransforms).
+//
+// Arguments:
+//   opindex    the index of the operation
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+bool
+Pipeline::FoldsIntoNext(int opindex)
+{
+    if (opindex < 0 || opindex+1 >= (int)ops.size())
+        return false;
+    TransformOperation *a = dynamic_cast<TransformOperation*>(ops[opindex]);
+    TransformOperation *b = dynamic_cast<TransformOperation*>(ops[opindex+1]);
+    return (a && b &&
+            a->RewritesCoordinates() && b->RewritesCoordinates() &&
+            a->GetCoordinateSystemIndex() == b->GetCoordinateSystemIndex());
+}
+
+// ****************************************************************************
+// Method:  Pipeline::ExecuteFoldedTransforms
+//
+// Purpose:
+///   Execute a run of transforms which fold into each other, starting
+///   at ops[first], for one chunk.  Each result but the last gets the
+///   matrices so far set on its coordinate system, without touching
+///   the coordinate data; the last rewrites the run's input data once
+///   with all of the matrices composed.  Returns the index of the last
+///   operation in the run.
+///
+///   The matrices are for row vectors (see TransformOperation::
+///   GetMatrix), so a point p goes to p*A through the first and then to
+///   p*A*B through the second: each one multiplies on the right.  E.g.
+///   a translation by (1,0,0) and then a scale by 2 takes the origin to
+///   (2,0,0), where the other order would give (1,0,0).
+//
+// Arguments:
+//   first      the index of the first operation in the run
+//   chunk      the chunk index
+//   keys       the ResultCache key for each stage
+//   monitor    optional progress and cancellation callbacks
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:48:27 EDT 2026
+//   Compose the matrices in the order the points go through them, and
+//   free the copy-on-write input on every path.
+//
+// ****************************************************************************
+int
+Pipeline::ExecuteFoldedTransforms(int first, int chunk,
+                                  const std::vector<std::string> &keys,
+                                  ExecutionMonitor *monitor)
+{
+    int last = first;
+    while (FoldsIntoNext(last))
+        ++last;
+
+    eavlDataSet *input = results[first][chunk];
+    eavlMatrix4x4 M;
+    for (int i=first; i<=last; ++i)
+    {
+        if (monitor && monitor->Cancelled())
+            return last;
+
+        TransformOperation *op = dynamic_cast<TransformOperation*>(ops[i]);
+        // a point goes through ours after the earlier ones
+        M = M * op->GetMatrix();
+        if (results[i+1][chunk])
+            continue;
+
+        StageTimer timer;
+        stats[i+1][chunk].SetInput(input);
+        eavlDataSet *cow =
+            CreateCopyOnWriteInput(input, op->GetModifiedParts(input));
+        eavlDataSet *ds;
+        try
+        {
+            ds = op->ExecuteWithMatrix(cow, M, i == last);
+        }
+        catch (...)
+        {
+            FreeCopyOnWriteInput(input, cow, NULL);
+            throw;
+        }
+        FreeCopyOnWriteInput(input, cow, ds);
+        timer.Stop(stats[i+1][chunk]);
+        stats[i+1][chunk].SetOutput(ds);
+
+        results[i+1][chunk] = ResultCache::Add(keys[i+1], chunk, ds, false);
+        if (monitor)
+            monitor->PieceFinished(i+1, chunk);
+    }
+    return last;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetRenderTransform
+//
+// Purpose:
+///   Get the composed matrix of the transforms left for the renderer.
+///   These apply to the final result, in order, as if they came after
+///   every other operation.  Like ExecuteFoldedTransforms, we compose
+///   them for row vectors.  That's only true if nothing after them
+///   changes the coordinates (e.g. another transform, or an elevation),
+///   and the camera can only apply a uniform scale; otherwise we refuse
+///   and say why.  Returns false if there are none, or on an error.
+//
+// Arguments:
+//   M          (output) the composed matrix
+//   error      (output) why they can't be applied, or empty
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:04:15 EDT 2026
+//   Refuse to move a transform past a later one which changes the
+//   coordinates.  Check the scale here instead of in the operation,
+//   which no longer executes when only its settings change.
+//
+//   Jeremy Meredith, Mon Oct 19 02:48:27 EDT 2026
+//   Compose the matrices in the order the points go through them.
+//
+// ****************************************************************************
+bool
+Pipeline::GetRenderTransform(eavlMatrix4x4 &M, std::string &error)
+{
+    bool any = false;
+    error = "";
+    M.CreateIdentity();
+    for (size_t i=0; i<ops.size(); ++i)
+    {
+        TransformOperation *op = dynamic_cast<TransformOperation*>(ops[i]);
+        if (op && op->AppliesAtRenderTime())
+        {
+            if (!op->HasUniformScale())
+            {
+                error = "A transform at render time needs the same "
+                        "scale in x, y, and z.";
+                return false;
+            }
+            M = M * op->GetMatrix();
+            any = true;
+            continue;
+        }
+        if (!any)
+            continue;
+
+        // a transform sets its matrix on the coordinates even when it
+        // doesn't rewrite them; anything else tells us what it changes
+        bool changesCoords = (op != NULL);
+        if (!op && i < results.size() && !results[i].empty() && results[i][0])
+            changesCoords =
+                !ops[i]->GetModifiedParts(results[i][0]).coordinateSystems.empty();
+        if (changesCoords)
+        {
+            error = "A transform at render time can't come before " +
+                    ops[i]->GetOperationName() + ", which changes the "
+                    "coordinates.  Move it after, or turn off render time.";
+            return false;
+        }
+    }
+    return any;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetStageStats
+//
+// Purpose:
+///   Get the profiling stats for one stage of the last execution,
+///   summed over all chunks.  Stage 0 is reading the source, and stage
+///   i+1 is ops[i].
+//
+// Arguments:
+//   stage      the stage index
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+StageStats
+Pipeline::GetStageStats(int stage)
+{
+    StageStats sum;
+    if (stage < 0 || stage >= (int)stats.size())
+        return sum;
+    for (size_t c=0; c<stats[stage].size(); ++c)
+        sum.Add(stats[stage][c]);
+    // count the chunks we kept from before, too
+    sum.nchunks = stats[stage].size();
+    return sum;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::PrintStats
+//
+// Purpose:
+///   Write the profiling stats for the last execution, one line per
+///   stage, e.g. for logging batch runs.
+//
+// Arguments:
+//   out        the stream to write to
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Pipeline::PrintStats(ostream &out)
+{
+    out << GetName() << ": executed in " << executeTime << "s" << endl;
+    for (size_t i=0; i<stats.size(); ++i)
+    {
+        out << "  " << (i == 0 ? string("Read") : ops[i-1]->GetOperationName())
+            << ": ";
+        GetStageStats(i).Print(out);
+        out << endl;
+    }
+}
+
+// ****************************************************************************
+// Class:  PipelineAttributes
+//
+// Purpose:
+///   The part of a saved pipeline describing its source and the list of
+///   its operations.  In a saved pipeline, this is followed by the
+///   settings Attribute of each operation, in order.  A geometry source
+///   has a file of "(geometry)", and its GeometryAttributes come before
+///   the operations' settings.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Added the geometry source.
+//
+// ****************************************************************************
+class PipelineAttributes : public Attribute
+{
+  public:
+    string         file;
+    string         mesh;
+    vector<string> operations;
+  public:
+    virtual const char *GetType() {return "PipelineAttributes";}
+    PipelineAttributes() : Attribute()
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("file", file);
+        Add("mesh", mesh);
+        Add("operations", operations);
+    }
+};
+
+// ****************************************************************************
+// Function:  NewOperation
+//
+// Purpose:
+///   Create an operation of type T with default settings.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+template <class T>
+static Operation *
+NewOperation()
+{
+    return new T;
+}
+
+// ****************************************************************************
+// Struct:  OperationType
+//
+// Purpose:
+///   An operation a pipeline can have, by the name returned by its
+///   GetOperationName.  Both loading a pipeline (CreateOperation) and
+///   the GUI's operator menu (GetOperationNames) go by operationTypes,
+///   so a new operation only needs to be added there.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct OperationType
+{
+    const char *name;
+    Operation *(*create)();
+};
+
+static const OperationType operationTypes[] = {
+    {"Isosurface",     NewOperation<IsosurfaceOperation>},
+    {"Elevate",        NewOperation<ElevateOperation>},
+    {"ExternalFace",   NewOperation<ExternalFaceOperation>},
+    {"Histogram",      NewOperation<HistogramOperation>},
+    {"SurfaceNormals", NewOperation<SurfaceNormalsOperation>},
+    {"Threshold",      NewOperation<ThresholdOperation>},
+    {"Transform",      NewOperation<TransformOperation>},
+    {NULL,             NULL}
+};
+
+// ****************************************************************************
+// Method:  Pipeline::CreateOperation
+//
+// Purpose:
+///   Create a new operation with default settings given the name
+///   returned by its GetOperationName.  Returns NULL for an unknown name.
+//
+// Arguments:
+//   name       the operation name
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 03:16:42 EDT 2026
+//   Look the name up in operationTypes.
+//
+// ****************************************************************************
+Operation *
+Pipeline::CreateOperation(const std::string &name)
+{
+    for (int i=0; operationTypes[i].name != NULL; i++)
+    {
+        if (name == operationTypes[i].name)
+            return operationTypes[i].create();
+    }
+    return NULL;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::GetOperationNames
+//
+// Purpose:
+///   The names CreateOperation knows, in the order to offer them.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::vector<std::string>
+Pipeline::GetOperationNames()
+{
+    std::vector<std::string> names;
+    for (int i=0; operationTypes[i].name != NULL; i++)
+        names.push_back(operationTypes[i].name);
+    return names;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::Save
+//
+// Purpose:
+///   Write the source and operations (with their settings) so the
+///   pipeline can be recreated with Load, e.g. for a batch run.
+//
+// Arguments:
+//   out        the stream to write to
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Save a geometry source too.
+//
+// ****************************************************************************
+void
+Pipeline::Save(ostream &out)
+{
+    if (!source || source->sourcetype == Source::Pipe)
+        throw eavlException("can only save pipelines which read from a "
+                            "file or generate their mesh");
+
+    PipelineAttributes header;
+    bool generated = (source->sourcetype == Source::Geometry);
+    header.file = generated ? "(geometry)" : source->file;
+    header.mesh = source->GetMeshName();
+    for (size_t i=0; i<ops.size(); ++i)
+        header.operations.push_back(ops[i]->GetOperationName());
+    header.XMLSerialize(out);
+    if (generated)
+        source->geometry->XMLSerialize(out);
+
+    for (size_t i=0; i<ops.size(); ++i)
+        ops[i]->GetSettings()->XMLSerialize(out);
+}
+
+// ****************************************************************************
+// Method:  Pipeline::Load
+//
+// Purpose:
+///   Create a pipeline from a file written by Save, opening its source
+///   file with a new importer.
+//
+// Arguments:
+//   filename   the saved pipeline
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Load a geometry source too.
+//
+// ****************************************************************************
+Pipeline *
+Pipeline::Load(const std::string &filename)
+{
+    ifstream in(filename.c_str());
+    if (!in)
+        throw eavlException(string("couldn't open pipeline file ") + filename);
+    ostringstream contents;
+    contents << in.rdbuf();
+
+    Pipeline *pipe = new Pipeline;
+    XMLUnserializer *reader = Attribute::CreateXMLUnserializer(contents.str());
+    try
+    {
+        PipelineAttributes header;
+        header.XMLUnserialize(reader);
+        bool generated = (header.file == "(geometry)");
+        if (generated)
+        {
+            pipe->source->sourcetype = Source::Geometry;
+            pipe->source->geometry->XMLUnserialize(reader);
+        }
+        for (size_t i=0; i<header.operations.size(); ++i)
+        {
+            Operation *op = CreateOperation(header.operations[i]);
+            if (!op)
+                throw eavlException(string("unknown operation ") +
+                                    header.operations[i]);
+            pipe->ops.push_back(op);
+            op->GetSettings()->XMLUnserialize(reader);
+        }
+
+        if (!generated)
+        {
+            pipe->source->file = header.file;
+            pipe->source->mesh = header.mesh;
+            pipe->source->source_file =
+                eavlImporterFactory::GetImporterForFile(header.file);
+            if (!pipe->source->source_file)
+                throw eavlException(string("couldn't open ") + header.file);
+        }
+    }
+    catch (const Exception &e)
+    {
+        Attribute::FreeXMLUnserializer(reader);
+        delete pipe;
+        throw eavlException(string("error reading pipeline file ") +
+                            filename + ": " + e.message);
+    }
+    catch (...)
+    {
+        Attribute::FreeXMLUnserializer(reader);
+        delete pipe;
+        throw;
+    }
+    Attribute::FreeXMLUnserializer(reader);
+    return pipe;
+}
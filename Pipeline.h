@@ -4,9 +4,16 @@
 
 #include "STL.h"
 #include "eavlImporter.h"
+#include <set>
+#include <algorithm>
 #include "Operation.h"
+#include "CopyOnWrite.h"
 #include <QFileInfo>
 #include "DSInfo.h"
+#include "Geometry.h"
+#include "StageStats.h"
+#include "FieldStats.h"
+#include "eavlMatrix4x4.h"
 
 struct Pipeline;
 
@@ -15,11 +22,21 @@ struct Pipeline;
 //
 // Purpose:
 ///   Encapsulates settings for some type of source.
+///   A Pipe source starts from a result of another pipeline: the final
+///   one, or with source_stage >= 0, that stage (0 is what it read).
+///   A Geometry source generates its mesh (see GeometrySource).
 //
 // Programmer:  Jeremy Meredith
 // Creation:    August 3, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:04:36 EDT 2026
+//   Added the stage for a pipe source, and its info.
+//
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Added the geometry source, and access to the importer for either
+//   that or a file.
+//
 // ****************************************************************************
 struct Source
 {
@@ -27,19 +44,60 @@ struct Source
     SourceType    sourcetype;
 
     Pipeline     *source_pipe;
+    int           source_stage;
     
     eavlImporter *source_file;
     std::string   file;
     std::string   mesh;
     //std::string   var;
 
+    GeometryAttributes *geometry;
+    GeometrySource     *source_geometry;
+
   public:
     Source()
         : sourcetype(File),
           source_pipe(NULL),
+          source_stage(-1),
           source_file(NULL),
-          file(""), mesh("")
+          file(""), mesh(""),
+          geometry(new GeometryAttributes),
+          source_geometry(NULL)
+    {
+    }
+    /// The importer a File or Geometry source reads from, or NULL.
+    eavlImporter *GetImporter()
+    {
+        if (sourcetype == File)
+            return source_file;
+        else if (sourcetype == Geometry)
+            return source_geometry;
+        return NULL;
+    }
+    string GetMeshName()
     {
+        return (sourcetype == Geometry) ? "mesh" : mesh;
+    }
+    /// The fields a File or Geometry source can provide.
+    std::vector<std::string> GetFieldList()
+    {
+        if (sourcetype == File && source_file)
+            return source_file->GetFieldList(mesh);
+        else if (sourcetype == Geometry)
+            return GeometrySource::GetFields();
+        return std::vector<std::string>();
+    }
+    /// Make sure the generator matches the geometry settings.  Returns
+    /// true if it's a new one, since anything it made before is stale.
+    bool UpdateGeometry()
+    {
+        std::string key = GeometrySource::GetKey(*geometry);
+        if (source_geometry && source_geometry->GetKey() == key)
+            return false;
+        GeometrySource *g = new GeometrySource(*geometry);
+        delete source_geometry;
+        source_geometry = g;
+        return true;
     }
     string GetSourceType()
     {
@@ -52,23 +110,33 @@ struct Source
         else // sourcetype == Pipe
             return "Pipeline";
     }
-    string GetSourceInfo()
-    {
-        if (sourcetype == File && (file=="" || mesh==""))
-            return "";
-        else if (sourcetype == File)
-        {
-            return QFileInfo(file.c_str()).fileName().toStdString() + ":" + mesh;
-        }
-        else if (sourcetype == Geometry)
-        {
-            return "(some shape?)";
-        }
-        else // sourcetype == Pipe
-        {
-            return "(some pipe ID)";
-        }
-    }
+    string GetSourceInfo();
+};
+
+// ****************************************************************************
+// Struct:  ExecutionMonitor
+//
+// Purpose:
+///   Lets whoever runs Pipeline::Execute watch its progress and stop it.
+///   The piece methods are called from worker threads.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct ExecutionMonitor
+{
+    virtual ~ExecutionMonitor() { }
+    /// Called before any work with the number of pieces to compute,
+    /// where one piece is one stage for one chunk.
+    virtual void Begin(int /*npieces*/) { }
+    /// Called when a piece is done.  Stage 0 is reading the source, and
+    /// stage i+1 is ops[i].
+    virtual void PieceFinished(int /*stage*/, int /*chunk*/) { }
+    /// Checked before each piece; once this returns true, Execute stops
+    /// as soon as it can and throws.
+    virtual bool Cancelled() { return false; }
 };
 
 // ****************************************************************************
@@ -81,6 +149,74 @@ struct Source
 // Creation:    August 3, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 10:12:41 EDT 2026
+//   Only read the variables needed by the operations and by consumers,
+//   and read more on demand when someone asks for them.
+//
+//   Jeremy Meredith, Sun Oct 18 11:03:18 EDT 2026
+//   Added InvalidateResults so a change only re-executes what it affects.
+//   Operations get copy-on-write inputs so earlier results stay valid.
+//
+//   Jeremy Meredith, Sun Oct 18 13:40:02 EDT 2026
+//   Read every chunk of the mesh, not just the first one, and run each
+//   chunk through the operations in parallel.  Results are now kept per
+//   chunk.  Moved the larger methods to Pipeline.cpp.
+//
+//   Jeremy Meredith, Sun Oct 18 15:02:37 EDT 2026
+//   Execute can run on a worker thread and be monitored and cancelled.
+//   Consumers now use the published output rather than the results, so
+//   they keep showing the last complete result while a new one computes.
+//
+//   Jeremy Meredith, Sun Oct 18 16:21:09 EDT 2026
+//   Share results with other pipelines through the ResultCache.
+//
+//   Jeremy Meredith, Sun Oct 18 17:45:50 EDT 2026
+//   Added TrimCache to keep the ResultCache within its memory budget.
+//
+//   Jeremy Meredith, Sun Oct 18 19:10:26 EDT 2026
+//   Record profiling stats for each stage and chunk.
+//
+//   Jeremy Meredith, Sun Oct 18 20:05:44 EDT 2026
+//   Added Save and Load, and moved the operation factory here.
+//
+//   Jeremy Meredith, Sun Oct 18 21:17:52 EDT 2026
+//   Added GetFieldStats; GetVariables no longer computes ranges.
+//
+//   Jeremy Meredith, Sun Oct 18 23:41:27 EDT 2026
+//   Fold consecutive coordinate transforms, and added GetRenderTransform.
+//
+//   Jeremy Meredith, Sun Oct 18 23:52:18 EDT 2026
+//   Run operations which combine the chunks on all of them at once.
+//
+//   Jeremy Meredith, Mon Oct 19 00:04:36 EDT 2026
+//   Execute from another pipeline's result for a pipe source.  Added
+//   the stage to execute up to, and the helpers for pipe sources.
+//
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Added branches: pipelines taking their input from a stage of this
+//   one, which together make a tree hanging off one source.
+//
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Track whether a visible plot shows this pipeline, and added
+//   GetDemandedStage so we only execute what someone will look at.
+//   Publish only a complete final result.
+//
+//   Jeremy Meredith, Mon Oct 19 01:26:44 EDT 2026
+//   Remember when a requested variable needs reading, so whoever
+//   executes pipelines knows to (see NeedsExecute).
+//
+//   Jeremy Meredith, Mon Oct 19 02:04:15 EDT 2026
+//   Remember the stage keys of the results, and added
+//   InvalidateChangedResults, so a change to a transform left for the
+//   renderer doesn't re-execute anything.
+//
+//   Jeremy Meredith, Mon Oct 19 02:26:14 EDT 2026
+//   Added SetRequestedVariables and UpdateRequestedVariables, so the
+//   requested variables are only what someone currently wants.
+//
+//   Jeremy Meredith, Mon Oct 19 03:16:42 EDT 2026
+//   Added GetOperationNames, from the same table CreateOperation uses.
+//
 // ****************************************************************************
 struct Pipeline
 {
@@ -88,159 +224,262 @@ struct Pipeline
     std::vector<Operation*> ops;
     /// results should have one more item in it than the ops array.
     /// e.g. ops[i] uses results[i] as input and outputs to results[i+1].
-    /// result[0] is the initial data set.
-    std::vector<eavlDataSet*> results;
+    /// result[0] is the initial data set.  Each of these has one data
+    /// set per chunk of the source, e.g. results[i][c] is chunk c.
+    /// The data sets belong to the ResultCache, and an entry may be
+    /// NULL if the cache evicted it (see TrimCache).
+    std::vector< std::vector<eavlDataSet*> > results;
+    /// The ResultCache key of each stage of the results, as of the last
+    /// execution (see GetStageKeys).
+    std::vector<std::string> resultKeys;
+    /// The final result of the last complete execution, one data set per
+    /// chunk.  This is what windows draw; it only changes in Publish.
+    std::vector<eavlDataSet*> output;
+    /// Profiling for the last execution, laid out like the results.
+    /// (See GetStageStats for the sum over the chunks.)
+    std::vector< std::vector<StageStats> > stats;
+    /// Wall time of the last execution, in seconds.
+    double executeTime;
+    /// True while a worker thread is executing this pipeline, in which
+    /// case nothing else may touch it.  Only used from the GUI thread.
+    bool executing;
+    /// Variables a consumer of this pipeline (e.g. a plot or a branch)
+    /// has asked for, in addition to the ones the operations themselves
+    /// need.  Rebuilt whenever the demand changes (see
+    /// UpdateRequestedVariables).
+    std::set<std::string> requestedVars;
+    /// True if a plot in a visible window shows our output.  This is
+    /// kept up to date by the window manager (see UpdateDemand there).
+    bool viewed;
+    /// True if RequestVariable asked for something we haven't read, so
+    /// we need to execute again to get it.
+    bool readPending;
 
   public:
     ///\todo: hack: everyone needs to access these
     static vector<Pipeline*> allPipelines;
 
   public:
-    Pipeline() : source(new Source)
+    Pipeline() : source(new Source), executeTime(0), executing(false),
+                 viewed(false), readPending(false)
     {
     }
 
-    string GetName()
+    /// Get a name from the source and operations, optionally only the
+    /// ones up to some stage.
+    string GetName(int stage = -1)
     {
         if (!source)
             return "(empty)";
         string result = source->GetSourceInfo();
         if (result == "")
             return "(empty)";
-        for (unsigned int i=0; i<ops.size(); i++)
+        for (unsigned int i=0; i<ops.size() && (stage<0 || (int)i<stage); i++)
             result += string("+") + ops[i]->GetOperationShortName();
         return result;
     }
 
-    DSInfo GetVariables(int /*index*/)
+    /// True if this pipeline is p or takes its input from p, directly
+    /// or not.  (A pipe source must not make a loop.)
+    bool DependsOn(Pipeline *p)
     {
-        DSInfo dsinfo;
-        try
-        {
-            Execute();
-        }
-        catch (const eavlException &e)
-        {
-            cerr << "Error: " <<e.GetErrorText() << endl;
-            return dsinfo;
-        }
+        if (p == this)
+            return true;
+        return (source && source->sourcetype == Source::Pipe &&
+                source->source_pipe && source->source_pipe->DependsOn(p));
+    }
 
-        if (results.size() == 0)
-            return dsinfo;
+    /// Mark this pipeline, and any it takes its input from, as being
+    /// executed on a worker thread.
+    void MarkExecuting(bool e)
+    {
+        executing = e;
+        if (source && source->sourcetype == Source::Pipe && source->source_pipe)
+            source->source_pipe->MarkExecuting(e);
+    }
 
-        eavlDataSet *ds = results.back();
-        for (int j=0; j<ds->GetNumFields(); ++j)
-        {
-            eavlField *f = ds->GetField(j);
-            if (f->GetAssociation() == eavlField::ASSOC_POINTS)
-            {
-                FieldInfo finfo;
-                finfo.name = f->GetArray()->GetName();
-                finfo.ncomp = f->GetArray()->GetNumberOfComponents();
-                finfo.minval = f->GetArray()->GetComponentWiseMin();
-                finfo.maxval = f->GetArray()->GetComponentWiseMax();
-                finfo.minmag = f->GetArray()->GetMagnitudeMin();
-                finfo.maxmag = f->GetArray()->GetMagnitudeMax();
-                dsinfo.nodalfields.push_back(finfo);
-            }
-        }
+    /// True if a worker thread is using this pipeline, or any it takes
+    /// its input from, so we can't execute it here.
+    bool IsBusy()
+    {
+        if (executing)
+            return true;
+        return (source && source->sourcetype == Source::Pipe &&
+                source->source_pipe && source->source_pipe->IsBusy());
+    }
+
+    std::vector<Pipeline*> GetBranches();
+    std::vector<Pipeline*> GetDownstream();
+    Pipeline *CreateBranch(int stage);
+    int GetDemandedStage();
+
+    /// True if every chunk of a stage's result is there.
+    bool HasResult(int stage)
+    {
+        if (stage < 0 || stage >= (int)results.size())
+            return false;
+        return (std::find(results[stage].begin(), results[stage].end(),
+                          (eavlDataSet*)NULL) == results[stage].end());
+    }
 
+    /// True if we're viewed but aren't showing our latest final result,
+    /// e.g. because we were dormant when something changed, or a plot
+    /// wants a variable we haven't read.
+    bool NeedsExecute()
+    {
+        if (!viewed)
+            return false;
+        return (readPending ||
+                !HasResult(ops.size()) || output != results.back());
+    }
 
-        for (int i=0; i<ds->GetNumCellSets(); ++i)
+    DSInfo GetVariables(int index);
+    FieldStats GetFieldStats(const std::string &name, int stage = -1);
+    std::vector<std::string> GetNeededVariables();
+    std::vector<std::string> GetUnloadedVariables();
+    bool RequestVariable(const std::string &name);
+    bool SetRequestedVariables(const std::set<std::string> &names);
+    static bool UpdateRequestedVariables(
+        const std::map<Pipeline*, std::set<std::string> > &plotted);
+
+    static bool HasField(eavlDataSet *ds, const std::string &name)
+    {
+        for (int i=0; i<ds->GetNumFields(); ++i)
         {
-            eavlCellSet *cs = ds->GetCellSet(i);
-            CellSetInfo csinfo;
-            csinfo.name = cs->GetName();
-            csinfo.topodim = cs->GetDimensionality();
-            dsinfo.cellsets.push_back(csinfo);
-            for (int j=0; j<ds->GetNumFields(); ++j)
-            {
-                eavlField *f = ds->GetField(j);
-                if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
-                    f->GetAssocCellSet() == cs->GetName())
-                {
-                    FieldInfo finfo;
-                    finfo.name = f->GetArray()->GetName();
-                    finfo.ncomp = f->GetArray()->GetNumberOfComponents();
-                    finfo.minval = f->GetArray()->GetComponentWiseMin();
-                    finfo.maxval = f->GetArray()->GetComponentWiseMax();
-                    finfo.minmag = f->GetArray()->GetMagnitudeMin();
-                    finfo.maxmag = f->GetArray()->GetMagnitudeMax();
-                    dsinfo.cellsetfields[cs->GetName()].push_back(finfo);
-                }
-            }
+            if (ds->GetField(i)->GetArray()->GetName() == name)
+                return true;
         }
+        return false;
+    }
 
-        //cerr << ">> GetVariables <<\n"; dsinfo.Print(cerr);
-        return dsinfo;
+    /// Get the number of chunks in the results, i.e. in the source.
+    int GetNumChunks()
+    {
+        if (results.size() == 0)
+            return 0;
+        return results[0].size();
     }
 
     void ClearResults()
     {
         results.clear();
+        resultKeys.clear();
+        stats.clear();
     }
 
-    void Execute()
+    /// Discard the results produced by ops[opindex] and everything after
+    /// it, keeping the earlier ones (including its input) for reuse.
+    /// Operations never change an earlier result (see
+    /// CreateCopyOnWriteInput), so those are still good.
+    void InvalidateResults(int opindex)
     {
-        //cerr << "\n\n>>>>EXECUTE\n\n\n";
-
-        if (results.size() == 0)
+        if (opindex < 0)
         {
-            if (source->sourcetype != Source::File)
-                throw eavlException("can only execute from source file");
-
-            if (!source->source_file)
-                throw eavlException("no source file selected");
-
-#if 0
-            // find the variables needed for each operation
-            std::vector<std::string> vars;
-            for (unsigned int i=ops.size()-1; i>=0; --i)
-            {
-                std::vector<std::string> newvars;
-                newvars = ops[i]->GetNeededVariables();
-                vars.insert(vars.end(), newvars.begin(), newvars.end());
-            }
-#else
-            ///\todo: big hack: always read everything from the file;
-            /// we eventually should change this so it only reads what's
-            /// asked of it
-            std::vector<std::string> vars = source->source_file->GetFieldList(source->mesh);
-#endif
-
-
-            // read the mesh and vars
-            ///\todo: only reading chunk 0 for now
-            eavlDataSet *ds = source->source_file->GetMesh(source->mesh, 0);
-
-            ds = ds->CreateShallowCopy();
-            for (size_t i=0; i<vars.size(); i++)
-            {
-                eavlField *f = source->source_file->GetField(vars[i], source->mesh, 0);
-                ds->AddField(f);
-            }
-            results.push_back(ds);
+            ClearResults();
+            return;
         }
+        if ((int)results.size() > opindex+1)
+            results.resize(opindex+1);
+        if ((int)resultKeys.size() > opindex+1)
+            resultKeys.resize(opindex+1);
+        if ((int)stats.size() > opindex+1)
+            stats.resize(opindex+1);
+    }
 
-        while (results.size() <= ops.size())
+    /// Discard what a change to the settings of ops[opindex] affects.
+    /// If its stage key didn't change (e.g. it's a transform left for
+    /// the renderer, which the keys leave out), no result did either,
+    /// and nothing is discarded.  Returns true if anything might be.
+    bool InvalidateChangedResults(int opindex)
+    {
+        int stage = opindex+1;
+        if (stage > 0 && stage < (int)resultKeys.size() &&
+            GetStageKeys(GetNeededVariables())[stage] == resultKeys[stage])
         {
-            eavlDataSet *ds = results.back();
+            return false;
+        }
+        InvalidateResults(opindex);
+        return true;
+    }
 
-            // \todo: hack: create a new data set structure so our mutators
-            // don't quite so easily mess with the one in the importer.
-            ds = ds->CreateShallowCopy();
+    /// Make the latest final result the one consumers see.  If we only
+    /// executed as far as a branch needed, there's nothing new to show.
+    void Publish()
+    {
+        if (HasResult(ops.size()))
+            output = results.back();
+    }
 
-            // execute each operation
-            Operation *op = ops[results.size()-1];
-            op->SetInput(ds);
-            op->Execute();
-            results.push_back(op->GetOutput());
+    void Execute(ExecutionMonitor *monitor = NULL, int lastStage = -1);
+    void PullFromSourcePipe(ExecutionMonitor *monitor);
+    void RequestSourceVariables();
+    int GetSourcePipeStage();
+    void ExecuteChunk(int chunk, const std::vector<std::string> &vars,
+                      const std::vector<std::string> &keys,
+                      int endStage, ExecutionMonitor *monitor);
+    bool FindResult(int stage, int chunk, const std::vector<std::string> &keys,
+                    ExecutionMonitor *monitor);
+    std::vector<int> GetCombinedStages(const std::vector<std::string> &keys,
+                                       int endStage, ExecutionMonitor *monitor);
+    void ExecuteCombinedStage(int opindex, const std::vector<std::string> &keys,
+                              ExecutionMonitor *monitor);
+    std::vector<std::string> GetStageKeys(const std::vector<std::string> &vars);
+    bool FoldsIntoNext(int opindex);
+    int ExecuteFoldedTransforms(int first, int chunk,
+                                const std::vector<std::string> &keys,
+                                ExecutionMonitor *monitor);
+    bool GetRenderTransform(eavlMatrix4x4 &M, std::string &error);
 
-            //cerr << "Executed op to generate result["<<results.size()<<", summary = \n";
-            //op->GetOutput()->PrintSummary(cerr);
-        }
-    }
+    static void TrimCache();
+
+    StageStats GetStageStats(int stage);
+    void PrintStats(ostream &out);
+
+    void Save(ostream &out);
+    static Pipeline *Load(const std::string &filename);
+    static Operation *CreateOperation(const std::string &name);
+    static std::vector<std::string> GetOperationNames();
 };
 
+// ****************************************************************************
+// Method:  Source::GetSourceInfo
+//
+// Purpose:
+///   Describe the file and mesh, or the pipeline and stage, we use.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    August 3, 2012
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:04:36 EDT 2026
+//   Describe a pipe source by its pipeline's name up to the stage.
+//
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Describe a geometry source by its shape and size.
+//
+// ****************************************************************************
+inline string
+Source::GetSourceInfo()
+{
+    if (sourcetype == File && (file=="" || mesh==""))
+        return "";
+    else if (sourcetype == File)
+    {
+        return QFileInfo(file.c_str()).fileName().toStdString() + ":" + mesh;
+    }
+    else if (sourcetype == Geometry)
+    {
+        ostringstream os;
+        os << geometry->shape << " " << geometry->ni << "x"
+           << geometry->nj << "x" << geometry->nk;
+        return os.str();
+    }
+    else // sourcetype == Pipe
+    {
+        if (!source_pipe)
+            return "";
+        return "[" + source_pipe->GetName(source_stage) + "]";
+    }
+}
 
 #endif
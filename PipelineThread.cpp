@@ -0,0 +1,217 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "PipelineThread.h"
+
+#include <QMutexLocker>
+
+// ****************************************************************************
+// Constructor:  PipelineThread::PipelineThread
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+PipelineThread::PipelineThread(QObject *parent)
+    : QThread(parent), pipe(NULL), current(NULL), cancelled(0),
+      npieces(0), ndone(0)
+{
+}
+
+// ****************************************************************************
+// Method:  PipelineThread::Start
+//
+// Purpose:
+///   Start executing the given pipeline and its branches.  The caller
+///   must make sure we're not already running, and must leave the
+///   pipelines alone until we finish.  The pipeline we're given is
+///   executed even if nobody views it yet, since that's how it first
+///   gets into a window; its branches stay dormant unless they're needed.
+//
+// Arguments:
+//   p          the pipeline to execute
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:13:05 EDT 2026
+//   Mark the pipelines we pull from as executing too.
+//
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Mark the branches as executing too.
+//
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Skip the branches nobody needs, and only execute each pipeline as
+//   far as anyone needs.
+//
+// ****************************************************************************
+void
+PipelineThread::Start(Pipeline *p)
+{
+    pipe = p;
+    pipes.clear();
+    stages.clear();
+    // -1 (nobody needs it) means all of it
+    pipes.push_back(pipe);
+    stages.push_back(pipe->GetDemandedStage());
+    std::vector<Pipeline*> downstream = pipe->GetDownstream();
+    for (size_t i=0; i<downstream.size(); ++i)
+    {
+        int stage = downstream[i]->GetDemandedStage();
+        if (stage < 0)
+            continue;
+        pipes.push_back(downstream[i]);
+        stages.push_back(stage);
+    }
+    finished.clear();
+    for (size_t i=0; i<pipes.size(); ++i)
+        pipes[i]->MarkExecuting(true);
+    cancelled = 0;
+    error = "";
+    npieces = 0;
+    ndone = 0;
+    start();
+}
+
+// ****************************************************************************
+// Method:  PipelineThread::Cancel
+//
+// Purpose:
+///   Ask execution to stop after the pieces currently executing.  This
+///   doesn't wait; the thread finishes as usual (see QThread::finished),
+///   and the pipelines stay marked as executing until whoever handles
+///   that unmarks them.  Results which were completed for every chunk
+///   are kept for next time.  Call wait() afterwards to block instead.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:13:05 EDT 2026
+//   Mark the pipelines we pull from as executing too.
+//
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Unmark the branches too.
+//
+//   Jeremy Meredith, Mon Oct 19 02:10:37 EDT 2026
+//   Don't wait for the thread, so the GUI never blocks on a cancel.
+//   The pipelines are unmarked when it finishes.
+//
+// ****************************************************************************
+void
+PipelineThread::Cancel()
+{
+    if (!isRunning())
+        return;
+    cancelled = 1;
+}
+
+// ****************************************************************************
+// Method:  PipelineThread::Begin
+//
+// Purpose:
+///   ExecutionMonitor callback with the amount of work to be done.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+PipelineThread::Begin(int n)
+{
+    QMutexLocker lock(&progressLock);
+    npieces = n;
+    ndone = 0;
+    emit progress(0, npieces, "Starting");
+}
+
+// ****************************************************************************
+// Method:  PipelineThread::PieceFinished
+//
+// Purpose:
+///   ExecutionMonitor callback; this is called from the thread pool.
+//
+// Arguments:
+//   stage      0 for reading, else the op index plus one
+//   chunk      the chunk index
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Name the stage of whichever pipeline is executing.
+//
+// ****************************************************************************
+void
+PipelineThread::PieceFinished(int stage, int chunk)
+{
+    QString what;
+    if (stage == 0)
+        what = "Read";
+    else
+        what = current->ops[stage-1]->GetOperationName().c_str();
+    what += QString(" (chunk %1)").arg(chunk);
+
+    QMutexLocker lock(&progressLock);
+    // re-reading variables for an existing chunk isn't counted up front
+    if (ndone < npieces)
+        ++ndone;
+    emit progress(ndone, npieces, what);
+}
+
+// ****************************************************************************
+// Method:  PipelineThread::run
+//
+// Purpose:
+///   QThread method; executes the pipeline, then its branches.  We stop
+///   at the first error, keeping what was finished.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Execute the branches too.
+//
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Stop each one at its demanded stage.
+//
+//   Jeremy Meredith, Mon Oct 19 01:26:44 EDT 2026
+//   Report any other exception as an error too, rather than letting it
+//   out of the thread, so the pipelines are still unmarked as executing.
+//
+// ****************************************************************************
+void
+PipelineThread::run()
+{
+    // let each pipeline know what its branches will ask for first, so
+    // it doesn't have to go back and read more for them
+    for (size_t i=pipes.size()-1; i>0; --i)
+        pipes[i]->RequestSourceVariables();
+
+    for (size_t i=0; i<pipes.size() && !Cancelled(); ++i)
+    {
+        current = pipes[i];
+        try
+        {
+            current->Execute(this, stages[i]);
+            finished.push_back(current);
+        }
+        catch (const eavlException &e)
+        {
+            error = e.GetErrorText();
+        }
+        catch (...)
+        {
+            error = "unexpected error";
+        }
+        if (!error.empty())
+        {
+            if (current != pipe)
+                error = "In branch " + current->GetName() + ": " + error;
+            return;
+        }
+    }
+}
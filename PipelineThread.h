@@ -0,0 +1,76 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef PIPELINE_THREAD_H
+#define PIPELINE_THREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <QAtomicInt>
+#include "Pipeline.h"
+
+// ****************************************************************************
+// Class:  PipelineThread
+//
+// Purpose:
+///   Executes a pipeline on a worker thread so the GUI stays responsive.
+///   It reports progress with a signal, and can be cancelled, in which
+///   case the pipeline stops after the pieces currently executing.
+///   When the thread finishes (see QThread::finished), the caller checks
+///   for an error or cancellation and publishes the pipeline's output.
+///
+///   The branches of the pipeline (see Pipeline::GetDownstream) are
+///   executed after it, so everything hanging off it is brought up to
+///   date with each stage executing once.  Only the branches someone
+///   is looking at are executed, and each pipeline only as far as
+///   anyone needs (see Pipeline::GetDemandedStage).
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:32:10 EDT 2026
+//   Execute the branches too.
+//
+//   Jeremy Meredith, Mon Oct 19 00:45:31 EDT 2026
+//   Skip the branches nobody views, and stop at the demanded stage.
+//
+// ****************************************************************************
+class PipelineThread : public QThread, public ExecutionMonitor
+{
+    Q_OBJECT
+  protected:
+    Pipeline    *pipe;
+    std::vector<Pipeline*> pipes;
+    std::vector<int>       stages;
+    std::vector<Pipeline*> finished;
+    Pipeline    *current;
+    QAtomicInt   cancelled;
+    std::string  error;
+    QMutex       progressLock;
+    int          npieces;
+    int          ndone;
+
+  public:
+    PipelineThread(QObject *parent);
+    void         Start(Pipeline *p);
+    void         Cancel();
+    Pipeline    *GetPipeline() { return pipe; }
+    /// The pipeline and its demanded branches, marked as executing
+    /// until we finish.
+    const std::vector<Pipeline*> &GetPipelines() { return pipes; }
+    /// The ones of those which were brought up to date.
+    const std::vector<Pipeline*> &GetFinishedPipelines() { return finished; }
+    bool         WasCancelled() { return cancelled != 0; }
+    std::string  GetError() { return error; }
+
+    virtual void Begin(int n);
+    virtual void PieceFinished(int stage, int chunk);
+    virtual bool Cancelled() { return cancelled != 0; }
+
+  signals:
+    void progress(int done, int total, const QString &what);
+
+  protected:
+    virtual void run();
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include "eavlView.h"
 #include "eavlPlot.h"
 #include "eavlColorTable.h"
+#include "Proxies.h"
 
 struct Plot
 {
@@ -18,9 +19,33 @@ struct Plot
     eavlColor color;
     bool wireframe;
     void (*xform)(double,double,double,double&,double&,double&);
-    eavlPlot *eavlplot;
+    /// one EAVL plot per chunk of the pipeline's final result
+    std::vector<eavlPlot*> eavlplots;
+    /// the data sets and cell set eavlplots were created from
+    std::vector<eavlDataSet*> plotds;
+    string plotcellset;
+    /// stand-ins for eavlplots to draw while the view is moving (see
+    /// GetInteractivePlots), and the proxy data sets they were made
+    /// from; NULL where there isn't one
+    std::vector<eavlPlot*> proxyplots;
+    std::vector<eavlDataSet*> proxyds;
     bool valid;
 
+    /// The settings last applied to eavlplots.  Each kind of setting
+    /// rebuilds something different in the EAVL plots (the field
+    /// rebuilds the scalars, the color table rebuilds its texture), so
+    /// we only reapply the ones which changed.  Changing the cell set
+    /// or the data rebuilds the plots entirely (see UpdateDataSet).
+    bool appliedAny;
+    string appliedField;
+    string appliedColortable;
+    bool appliedReversect;
+    bool appliedLogct;
+    eavlColor appliedColor;
+    bool appliedWireframe;
+    bool appliedBarsFor1D;
+    void (*appliedXform)(double,double,double,double&,double&,double&);
+
     // these two are hacks; need a better way to get this info
     // to create the right type of plots....
     bool oneDimensional;
@@ -35,57 +60,199 @@ struct Plot
              color(eavlColor::grey50),
              wireframe(false),
              xform(NULL),
-             eavlplot(NULL),
-             valid(true)
+             valid(true),
+             appliedAny(false),
+             appliedBarsFor1D(false)
     {
         oneDimensional = false;
         barsFor1D = false;
     }
-    void UpdateDataSet(eavlDataSet *)
+    void UpdateDataSet()
     {
         //cerr << "update data set\n";
-        delete eavlplot;
-        eavlplot = NULL;
+        for (size_t i=0; i<eavlplots.size(); i++)
+            delete eavlplots[i];
+        eavlplots.clear();
+        plotds.clear();
+        appliedAny = false;
+        ClearProxyPlots();
+    }
+    void ClearProxyPlots()
+    {
+        for (size_t i=0; i<proxyplots.size(); i++)
+            delete proxyplots[i];
+        proxyplots.clear();
+        proxyds.clear();
+    }
+    static bool SameColor(const eavlColor &a, const eavlColor &b)
+    {
+        return (a.c[0] == b.c[0] && a.c[1] == b.c[1] &&
+                a.c[2] == b.c[2] && a.c[3] == b.c[3]);
     }
     void CreateEAVLPlot()
     {
         try
         {
-            // Create the EAVL Plot if needed
-            //cerr << "ELPlot: creating? " << (eavlplot) << endl;
-            if (!eavlplot)
+            // If we want a field the pipeline didn't read, the window
+            // manager has asked for it (see UpdateDemand there), and
+            // we'll be redrawn when it's been read; until then we
+            // draw without it.
+            if (!eavlplots.empty() &&
+                (plotds != pipe->output || cellset != plotcellset))
+                UpdateDataSet();
+
+            // Create the EAVL Plots if needed, one for each chunk
+            //cerr << "ELPlot: creating? " << (eavlplots.size()) << endl;
+            if (eavlplots.empty())
             {
-                if (oneDimensional)
-                {
-                    eavlplot = new eavl1DPlot(pipe->results.back(), cellset);
-                    dynamic_cast<eavl1DPlot*>(eavlplot)->SetBarStyle(barsFor1D);
-                }
-                else
+                plotds = pipe->output;
+                plotcellset = cellset;
+                for (size_t c=0; c<plotds.size(); c++)
                 {
-                    eavlplot = new eavlPlot(pipe->results.back(), cellset);
-                    //cerr << "new eavlplot = " << eavlplot << endl;
+                    // e.g. an isosurface may miss some chunks entirely
+                    if (plotds[c]->GetNumPoints() == 0)
+                        continue;
+                    if (oneDimensional)
+                    {
+                        eavl1DPlot *p = new eavl1DPlot(plotds[c], cellset);
+                        p->SetBarStyle(barsFor1D);
+                        eavlplots.push_back(p);
+                        appliedBarsFor1D = barsFor1D;
+                    }
+                    else
+                    {
+                        eavlplots.push_back(new eavlPlot(plotds[c], cellset));
+                    }
                 }
             }
 
-            // update its values
+            // update whatever changed since last time; on a repaint
+            // where nothing did, this does no work at all
+            bool newField = !appliedAny || field != appliedField;
+            if (newField || xform != appliedXform ||
+                !SameColor(color, appliedColor) ||
+                wireframe != appliedWireframe ||
+                colortable != appliedColortable ||
+                reversect != appliedReversect || logct != appliedLogct)
+                ClearProxyPlots();
+            for (size_t i=0; i<eavlplots.size(); i++)
+            {
+                eavlPlot *p = eavlplots[i];
+                if (!appliedAny || xform != appliedXform)
+                    p->SetTransformFunction(xform);
+                if (newField)
+                    p->SetField(field);
+                if (!appliedAny || !SameColor(color, appliedColor))
+                    p->SetSingleColor(color);
+                if (!appliedAny || wireframe != appliedWireframe)
+                    p->SetWireframe(wireframe);
+                if (!appliedAny || colortable != appliedColortable ||
+                    reversect != appliedReversect)
+                    p->SetColorTableByName(colortable,reversect);
+                if (!appliedAny || logct != appliedLogct)
+                    p->SetLogarithmicColorScaling(logct);
+                if (oneDimensional && barsFor1D != appliedBarsFor1D)
+                    ((eavl1DPlot*)p)->SetBarStyle(barsFor1D);
+            }
 
-            if (xform)
-                eavlplot->SetTransformFunction(xform);
+            // color every chunk against the same range
+            if (newField && eavlplots.size() > 1 && field != "")
+            {
+                double minval = eavlplots[0]->GetMinDataExtent();
+                double maxval = eavlplots[0]->GetMaxDataExtent();
+                for (size_t i=1; i<eavlplots.size(); i++)
+                {
+                    minval = std::min(minval, eavlplots[i]->GetMinDataExtent());
+                    maxval = std::max(maxval, eavlplots[i]->GetMaxDataExtent());
+                }
+                for (size_t i=0; i<eavlplots.size(); i++)
+                    eavlplots[i]->SetDataExtents(minval, maxval);
+            }
 
-            eavlplot->SetField(field);
-            eavlplot->SetSingleColor(color);
-            eavlplot->SetWireframe(wireframe);
-            eavlplot->SetColorTableByName(colortable,reversect);
-            eavlplot->SetLogarithmicColorScaling(logct);
+            appliedAny = !eavlplots.empty();
+            appliedField = field;
+            appliedColortable = colortable;
+            appliedReversect = reversect;
+            appliedLogct = logct;
+            appliedColor = color;
+            appliedWireframe = wireframe;
+            appliedBarsFor1D = barsFor1D;
+            appliedXform = xform;
 
             valid = true;
         }
         catch (...)
         {
-            eavlplot = NULL;
+            UpdateDataSet();
             valid = false;
         }
     }
+    /// Start building the proxies of the chunks we're plotting, so
+    /// they're ready when the user moves the view.
+    void RequestProxies()
+    {
+        if (oneDimensional)
+            return;
+        for (size_t c=0; c<plotds.size(); c++)
+        {
+            if (plotds[c]->GetNumPoints() > 0)
+                ProxyCache::Request(plotds[c], plotcellset);
+        }
+    }
+    /// The plots to draw while the view is moving: the proxy of each
+    /// chunk's plot if it has one, and the plot itself if not.  Call
+    /// this after CreateEAVLPlot.
+    std::vector<eavlPlot*> GetInteractivePlots()
+    {
+        if (oneDimensional)
+            return eavlplots;
+        proxyplots.resize(eavlplots.size(), NULL);
+        proxyds.resize(eavlplots.size(), NULL);
+        std::vector<eavlPlot*> drawn;
+        // the same chunks CreateEAVLPlot made plots of
+        size_t j = 0;
+        for (size_t c=0; c<plotds.size() && j<eavlplots.size(); c++)
+        {
+            if (plotds[c]->GetNumPoints() == 0)
+                continue;
+            eavlDataSet *proxy = ProxyCache::Request(plotds[c], plotcellset);
+            if (proxy && proxy != proxyds[j])
+            {
+                delete proxyplots[j];
+                proxyplots[j] = CreateProxyPlot(proxy, eavlplots[j]);
+                proxyds[j] = proxy;
+            }
+            drawn.push_back(proxyplots[j] ? proxyplots[j] : eavlplots[j]);
+            j++;
+        }
+        return drawn;
+    }
+    /// A plot of a proxy like the full plot, or NULL if that fails
+    /// (e.g. it's colored by a volume's cell field, which a proxy of
+    /// its faces doesn't have).
+    eavlPlot *CreateProxyPlot(eavlDataSet *proxy, eavlPlot *full)
+    {
+        eavlPlot *p = NULL;
+        try
+        {
+            p = new eavlPlot(proxy, plotcellset);
+            p->SetTransformFunction(xform);
+            p->SetField(field);
+            p->SetSingleColor(color);
+            p->SetWireframe(wireframe);
+            p->SetColorTableByName(colortable,reversect);
+            p->SetLogarithmicColorScaling(logct);
+            if (field != "")
+                p->SetDataExtents(full->GetMinDataExtent(),
+                                  full->GetMaxDataExtent());
+            return p;
+        }
+        catch (...)
+        {
+            delete p;
+            return NULL;
+        }
+    }
 };
 
 #endif
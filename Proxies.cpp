@@ -0,0 +1,437 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "Proxies.h"
+#include "CopyOnWrite.h"
+#include "ExternalFaces.h"
+#include "ResultCache.h"
+
+#include <eavlCellSetExplicit.h>
+#include <eavlCoordinates.h>
+
+#include <QMutexLocker>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+#include <cfloat>
+
+/// Clusters along each axis of the data's bounds.
+static const int proxyGridSize = 128;
+/// The fewest cells worth making a proxy of.
+static const int proxyMinCells = 1 << 16;
+/// Points or cells we handle between checks for being abandoned.
+static const int proxyPollInterval = 1 << 16;
+
+/// The ResultCache tells us when it frees something a proxy uses.
+static bool forgetHookAdded = ResultCache::AddForgetHook(ProxyCache::Forget);
+
+QMutex                                      ProxyCache::lock;
+std::map<ProxyCache::Key,ProxyCache::Entry> ProxyCache::entries;
+
+static eavlCellSet *
+FindCellSet(eavlDataSet *ds, const std::string &name)
+{
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+    {
+        if (ds->GetCellSet(i)->GetName() == name)
+            return ds->GetCellSet(i);
+    }
+    return NULL;
+}
+
+static bool
+IsAbandoned(QAtomicInt *abandoned)
+{
+    return abandoned && abandoned->fetchAndAddRelaxed(0) != 0;
+}
+
+// ****************************************************************************
+// Method:  ProxyCache::Compute
+//
+// Purpose:
+///   Make the proxy of a 2D cell set by clustering its points: a data
+///   set of triangles on a cell set with the given name, with the
+///   point fields averaged over each cluster and the cell fields on the
+///   cell set copied from the cell each triangle came from.  Returns
+///   NULL if the cell set is too small to bother with, if the proxy
+///   wouldn't have many fewer cells, or if we were abandoned.
+//
+// Arguments:
+//   ds         the data set
+//   cs         the cell set to make the proxy of
+//   name       the name for the proxy's cell set
+//   abandoned  if non-NULL, set when we should give up
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlDataSet *
+ProxyCache::Compute(eavlDataSet *ds, eavlCellSet *cs, const std::string &name,
+                    QAtomicInt *abandoned)
+{
+    int ncells = cs->GetNumCells();
+    int npts = ds->GetNumPoints();
+    if (cs->GetDimensionality() != 2 || ncells < proxyMinCells || npts == 0)
+        return NULL;
+
+    // the points (in whatever coordinates they have) and their bounds
+    std::vector<float> pts(3 * size_t(npts));
+    double lo[3] = {DBL_MAX, DBL_MAX, DBL_MAX};
+    double hi[3] = {-DBL_MAX, -DBL_MAX, -DBL_MAX};
+    for (int i=0; i<npts; ++i)
+    {
+        if (i % proxyPollInterval == 0 && IsAbandoned(abandoned))
+            return NULL;
+        for (int d=0; d<3; ++d)
+        {
+            double v = ds->GetPoint(i, d);
+            pts[3*size_t(i)+d] = v;
+            lo[d] = std::min(lo[d], v);
+            hi[d] = std::max(hi[d], v);
+        }
+    }
+
+    // number the occupied grid cells as we come to them
+    const int G = proxyGridSize;
+    double scale[3];
+    for (int d=0; d<3; ++d)
+        scale[d] = (hi[d] > lo[d]) ? double(G) / (hi[d] - lo[d]) : 0.;
+    std::vector<int> gridCluster(G*G*G, -1);
+    std::vector<int> pointCluster(npts);
+    int nclusters = 0;
+    for (int i=0; i<npts; ++i)
+    {
+        int b[3];
+        for (int d=0; d<3; ++d)
+            b[d] = std::min(G-1, int((pts[3*size_t(i)+d] - lo[d]) * scale[d]));
+        int &c = gridCluster[(b[2]*G + b[1])*G + b[0]];
+        if (c < 0)
+            c = nclusters++;
+        pointCluster[i] = c;
+    }
+
+    // triangulate the cells on the clusters; most of the triangles
+    // land on fewer than three clusters and disappear
+    eavlExplicitConnectivity conn;
+    std::vector<int> source;
+    for (int i=0; i<ncells; ++i)
+    {
+        if (i % proxyPollInterval == 0 && IsAbandoned(abandoned))
+            return NULL;
+        eavlCell cell = cs->GetCellNodes(i);
+        if (cell.type != EAVL_TRI && cell.type != EAVL_QUAD &&
+            cell.type != EAVL_PIXEL && cell.type != EAVL_POLYGON)
+            continue;
+        int n = std::min(cell.numIndices, 12);
+        int nodes[12];
+        for (int j=0; j<n; ++j)
+            nodes[j] = cell.indices[j];
+        if (cell.type == EAVL_PIXEL)
+            std::swap(nodes[2], nodes[3]);
+        for (int t=1; t+1<n; ++t)
+        {
+            int tri[3] = {pointCluster[nodes[0]],
+                          pointCluster[nodes[t]],
+                          pointCluster[nodes[t+1]]};
+            if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2])
+                continue;
+            conn.AddElement(EAVL_TRI, 3, tri);
+            source.push_back(i);
+        }
+    }
+    if (source.size() > size_t(ncells) / 2)
+        return NULL;
+
+    eavlDataSet *proxy = new eavlDataSet;
+    proxy->SetNumPoints(nclusters);
+
+    // each cluster's point is the average of its points, and so are
+    // its point fields
+    std::vector<int> counts(nclusters, 0);
+    for (int i=0; i<npts; ++i)
+        counts[pointCluster[i]]++;
+    std::vector<double> sums(3 * size_t(nclusters), 0.);
+    for (int i=0; i<npts; ++i)
+        for (int d=0; d<3; ++d)
+            sums[3*size_t(pointCluster[i])+d] += pts[3*size_t(i)+d];
+    eavlFloatArray *coords = new eavlFloatArray("coords", 3, nclusters);
+    for (int c=0; c<nclusters; ++c)
+        for (int d=0; d<3; ++d)
+            coords->SetComponentFromDouble(c, d, sums[3*size_t(c)+d] /
+                                                 counts[c]);
+    proxy->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+
+    for (int f=0; f<ds->GetNumFields(); ++f)
+    {
+        eavlField *field = ds->GetField(f);
+        eavlArray *arr = field->GetArray();
+        int ncomp = arr->GetNumberOfComponents();
+        if (field->GetAssociation() == eavlField::ASSOC_POINTS &&
+            arr->GetNumberOfTuples() == npts && arr->GetName() != "coords")
+        {
+            std::vector<double> fsums(ncomp * size_t(nclusters), 0.);
+            for (int i=0; i<npts; ++i)
+                for (int k=0; k<ncomp; ++k)
+                    fsums[ncomp*size_t(pointCluster[i])+k] +=
+                        arr->GetComponentAsDouble(i, k);
+            eavlFloatArray *out = new eavlFloatArray(arr->GetName(), ncomp,
+                                                     nclusters);
+            for (int c=0; c<nclusters; ++c)
+                for (int k=0; k<ncomp; ++k)
+                    out->SetComponentFromDouble(c, k, fsums[ncomp*size_t(c)+k] /
+                                                      counts[c]);
+            proxy->AddField(new eavlField(1, out, eavlField::ASSOC_POINTS));
+        }
+        else if (field->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                 field->GetAssocCellSet() == cs->GetName())
+        {
+            eavlFloatArray *out = new eavlFloatArray(arr->GetName(), ncomp,
+                                                     source.size());
+            for (size_t t=0; t<source.size(); ++t)
+                for (int k=0; k<ncomp; ++k)
+                    out->SetComponentFromDouble(t, k,
+                                      arr->GetComponentAsDouble(source[t], k));
+            proxy->AddField(new eavlField(0, out, eavlField::ASSOC_CELL_SET,
+                                          name));
+        }
+    }
+
+    eavlCoordinatesCartesian *cc =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    for (int d=0; d<3; ++d)
+        cc->SetAxis(d, new eavlCoordinateAxisField("coords", d));
+    proxy->AddCoordinateSystem(cc);
+
+    eavlCellSetExplicit *tris = new eavlCellSetExplicit(name, 2);
+    tris->SetCellNodeConnectivity(conn);
+    proxy->AddCellSet(tris);
+    return proxy;
+}
+
+// ****************************************************************************
+// Method:  ProxyCache::Build
+//
+// Purpose:
+///   Make the proxy for an entry Request added, from the thread pool.
+///   We read a shallow copy of the data set, whose parts Request
+///   retained for us, since the data set itself may be freed while we
+///   work; we release them and free the copy when we're done.
+///
+///   A volume's proxy is made from its external faces.  We compute our
+///   own instead of sharing the ExternalFaceCache's: its face sets
+///   belong to whichever result they end up in, and we only need ours
+///   until the proxy is made.  (The face table they come from is still
+///   shared, through the TopologyCache.)
+//
+// Arguments:
+//   ds         the data set, only used as the key
+//   cellset    the name of the cell set
+//   input      our shallow copy of the data set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:17:52 EDT 2026
+//   Work on our own copy with retained parts, and free the external
+//   faces we make.
+//
+// ****************************************************************************
+void
+ProxyCache::Build(eavlDataSet *ds, std::string cellset, eavlDataSet *input)
+{
+    Key key(ds, cellset);
+    QAtomicInt *abandoned;
+    {
+        // the entry stays put until we take it out (see Forget)
+        QMutexLocker locker(&lock);
+        abandoned = &entries[key].abandoned;
+    }
+
+    eavlDataSet *proxy = NULL;
+    eavlCellSet *faces = NULL;
+    try
+    {
+        eavlCellSet *cs = FindCellSet(input, cellset);
+        if (cs && cs->GetDimensionality() == 3)
+            cs = faces = ExternalFaceCache::Compute(cs);
+        if (cs)
+            proxy = Compute(input, cs, cellset, abandoned);
+    }
+    catch (...)
+    {
+        proxy = NULL;
+    }
+    delete faces;
+
+    // this may free the parts, and so call Forget, which takes our lock
+    ResultCache::ReleaseParts(input);
+    DeleteDataSetShell(input);
+
+    QMutexLocker locker(&lock);
+    Entry &entry = entries[key];
+    if (IsAbandoned(&entry.abandoned))
+    {
+        if (proxy)
+            Free(proxy);
+        entries.erase(key);
+    }
+    else
+    {
+        entry.proxy = proxy;
+        entry.building = false;
+    }
+}
+
+// ****************************************************************************
+// Method:  ProxyCache::Free
+//
+// Purpose:
+///   Free a proxy and everything in it, which is all ours.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:31:19 EDT 2026
+//   Free the data set, field, and coordinate system structures too.
+//
+// ****************************************************************************
+void
+ProxyCache::Free(eavlDataSet *proxy)
+{
+    for (int f=0; f<proxy->GetNumFields(); ++f)
+    {
+        delete proxy->GetField(f)->GetArray();
+        DeleteFieldShell(proxy->GetField(f));
+    }
+    for (int i=0; i<proxy->GetNumCoordinateSystems(); ++i)
+        delete proxy->GetCoordinateSystem(i);
+    for (int i=0; i<proxy->GetNumCellSets(); ++i)
+        delete proxy->GetCellSet(i);
+    DeleteDataSetShell(proxy);
+}
+
+// ****************************************************************************
+// Method:  ProxyCache::Request
+//
+// Purpose:
+///   Get the proxy of a cell set of a data set, or NULL if there isn't
+///   one (yet).  The first request for a 2D or 3D cell set of a cached
+///   data set starts building its proxy in the background; this never
+///   waits for it.
+//
+// Arguments:
+//   ds         the data set
+//   cellset    the name of the cell set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:31:19 EDT 2026
+//   The data set counts as one of the parts, since it may be freed
+//   before them.
+//
+//   Jeremy Meredith, Mon Oct 19 02:17:52 EDT 2026
+//   Give the build a copy of the data set with its parts retained.
+//   Don't compare sizes to catch a reused address; we're told to
+//   forget before anything is freed.
+//
+// ****************************************************************************
+eavlDataSet *
+ProxyCache::Request(eavlDataSet *ds, const std::string &cellset)
+{
+    eavlCellSet *cs = FindCellSet(ds, cellset);
+    if (!cs || cs->GetDimensionality() < 2)
+        return NULL;
+
+    Key key(ds, cellset);
+    {
+        QMutexLocker locker(&lock);
+        std::map<Key,Entry>::iterator it = entries.find(key);
+        if (it != entries.end())
+            return it->second.proxy;
+    }
+
+    // the ResultCache takes its lock before ours (see Forget), so this
+    // is done without ours
+    eavlDataSet *input = ds->CreateShallowCopy();
+    if (!ResultCache::RetainParts(input))
+    {
+        DeleteDataSetShell(input);
+        return NULL;
+    }
+
+    QMutexLocker locker(&lock);
+    if (entries.count(key))
+    {
+        // someone else started it in the meantime
+        locker.unlock();
+        ResultCache::ReleaseParts(input);
+        DeleteDataSetShell(input);
+        return NULL;
+    }
+    Entry &entry = entries[key];
+    entry.proxy = NULL;
+    entry.building = true;
+    entry.parts.push_back(ds);
+    entry.parts.push_back(cs);
+    for (int f=0; f<ds->GetNumFields(); ++f)
+        entry.parts.push_back(ds->GetField(f)->GetArray());
+    QtConcurrent::run(Build, ds, cellset, input);
+    return NULL;
+}
+
+// ****************************************************************************
+// Method:  ProxyCache::Forget
+//
+// Purpose:
+///   Forget (and free) any proxy made from a data set, array, or cell
+///   set which is about to be freed.  This is called under the
+///   ResultCache's lock, so it never waits: a proxy still being built
+///   is marked abandoned, and the build frees it and its entry.  The
+///   build has its own references to the parts it reads, so the part
+///   being freed here isn't one of them.  (The topology it may be
+///   reading, which ForgetDerived drops before calling us, is counted
+///   by the TopologyCache and outlives the build too.)
+//
+// Arguments:
+//   part       the data set, array, or cell set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:17:52 EDT 2026
+//   Don't wait for a build; leave it to free its own proxy.
+//
+// ****************************************************************************
+void
+ProxyCache::Forget(void *part)
+{
+    QMutexLocker locker(&lock);
+    std::map<Key,Entry>::iterator it = entries.begin();
+    while (it != entries.end())
+    {
+        Entry &entry = it->second;
+        if (std::find(entry.parts.begin(), entry.parts.end(), part) ==
+            entry.parts.end())
+        {
+            ++it;
+            continue;
+        }
+        if (entry.building)
+        {
+            entry.abandoned.fetchAndStoreRelaxed(1);
+            ++it;
+            continue;
+        }
+        if (entry.proxy)
+            Free(entry.proxy);
+        entries.erase(it++);
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef PROXIES_H
+#define PROXIES_H
+
+#include "STL.h"
+#include "eavlCellSet.h"
+#include "eavlDataSet.h"
+#include <QAtomicInt>
+#include <QMutex>
+
+// ****************************************************************************
+// Class:  ProxyCache
+//
+// Purpose:
+///   Makes and remembers coarse stand-ins for the surfaces of data sets,
+///   for a 3D window to draw while the user is moving the view.  A
+///   proxy is a triangle mesh made by clustering the points onto a
+///   coarse grid (each cluster a single point at their average, with
+///   their point fields averaged), so the shape and coloring survive
+///   but most of the triangles collapse away.  A volume's proxy is made
+///   from its external faces.
+///
+///   Proxies are built in the background the first time they're asked
+///   for; until then, and for a surface too small to be worth it, there
+///   isn't one.  When the ResultCache frees something a proxy was made
+///   from, it tells us to forget it.
+///
+///   A build holds its own references to the parts it reads (see
+///   ResultCache::RetainParts), so they can't be freed under it; being
+///   told to forget while a build is running only marks its entry
+///   abandoned, and the build frees the proxy when it sees that.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 02:17:52 EDT 2026
+//   Builds hold references to their parts, so Forget never waits.
+//
+// ****************************************************************************
+class ProxyCache
+{
+  protected:
+    typedef std::pair<eavlDataSet*,std::string> Key;
+    struct Entry
+    {
+        eavlDataSet       *proxy;
+        /// the data set, arrays, and cell sets it's made from
+        std::vector<void*> parts;
+        bool               building;
+        /// set to stop the build early
+        QAtomicInt         abandoned;
+    };
+    static QMutex              lock;
+    static std::map<Key,Entry> entries;
+
+    static void Build(eavlDataSet *ds, std::string cellset,
+                      eavlDataSet *input);
+    static void Free(eavlDataSet *proxy);
+
+  public:
+    static eavlDataSet *Request(eavlDataSet *ds, const std::string &cellset);
+    static void         Forget(void *part);
+
+    static eavlDataSet *Compute(eavlDataSet *ds, eavlCellSet *cs,
+                                const std::string &name,
+                                QAtomicInt *abandoned = NULL);
+};
+
+#endif
@@ -0,0 +1,791 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "ResultCache.h"
+#include "CopyOnWrite.h"
+#include "ExternalFaces.h"
+#include "FieldStats.h"
+#include "SortedIndex.h"
+#include "SpanSpace.h"
+#include "Topology.h"
+
+#include <QMutexLocker>
+#include <algorithm>
+#include <eavlArray.h>
+#include <eavlCellSetAllStructured.h>
+#include <eavlCellSetExplicit.h>
+
+QMutex                                  ResultCache::lock;
+ResultCache::EntryMap                   ResultCache::entries;
+std::map<void*, ResultCache::Part>      ResultCache::parts;
+size_t                                  ResultCache::budget = size_t(2048) << 20;
+size_t                                  ResultCache::used = 0;
+size_t                                  ResultCache::maxExternal = 256;
+unsigned long                           ResultCache::useCounter = 0;
+QMutex                                  ResultCache::derivedLock;
+size_t                                  ResultCache::derived = 0;
+
+// ****************************************************************************
+// Function:  GetArrayBytes
+//
+// Purpose:
+///   The memory held by an array's values.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static size_t
+GetArrayBytes(eavlArray *arr)
+{
+    size_t n = size_t(arr->GetNumberOfTuples()) * arr->GetNumberOfComponents();
+    if (dynamic_cast<eavlByteArray*>(arr))
+        return n;
+    return n * 4; // float and int
+}
+
+// ****************************************************************************
+// Function:  GetCellSetBytes
+//
+// Purpose:
+///   The memory held by a cell set's connectivity, approximately.
+///   Structured cell sets are implicit and take nothing.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static size_t
+GetCellSetBytes(eavlCellSet *cs)
+{
+    if (dynamic_cast<eavlCellSetAllStructured*>(cs))
+        return 0;
+
+    int ncells = cs->GetNumCells();
+    if (dynamic_cast<eavlCellSetExplicit*>(cs))
+    {
+        // shape, count, and node indices for each cell
+        size_t bytes = 0;
+        for (int i=0; i<ncells; ++i)
+            bytes += (cs->GetCellNodes(i).numIndices + 2) * sizeof(int);
+        return bytes;
+    }
+
+    // e.g. a subset, which keeps a list of cell indices
+    return size_t(ncells) * sizeof(int);
+}
+
+// ****************************************************************************
+// Method:  ResultCache::Find
+//
+// Purpose:
+///   Look up a result.  Returns NULL if it isn't in the cache.
+//
+// Arguments:
+//   key        the stage key
+//   chunk      the chunk index
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 17:45:50 EDT 2026
+//   Mark it as recently used.
+//
+// ****************************************************************************
+eavlDataSet *
+ResultCache::Find(const std::string &key, int chunk)
+{
+    QMutexLocker locker(&lock);
+    EntryMap::iterator it = entries.find(std::make_pair(key, chunk));
+    if (it == entries.end())
+        return NULL;
+    it->second.lastUse = ++useCounter;
+    return it->second.ds;
+}
+
+// ****************************************************************************
+// Method:  ResultCache::Add
+//
+// Purpose:
+///   Add a result to the cache.  If another thread got there first,
+///   we keep theirs and return it, so everyone shares the same one,
+///   and free whatever ours has that theirs doesn't share.
+///
+///   Measuring a cell set may mean walking all of its cells, so we
+///   measure the parts which are new to us before taking the lock for
+///   good.  (Anything another thread adds in between is measured twice,
+///   which is harmless.)
+//
+// Arguments:
+//   key        the stage key
+//   chunk      the chunk index
+//   ds         the result
+//   external   true if the data set's parts belong to someone else
+//              (i.e. an importer), so we must never free them
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 17:45:50 EDT 2026
+//   Account for its memory.
+//
+//   Jeremy Meredith, Mon Oct 19 01:31:19 EDT 2026
+//   Measure new parts outside the lock.  Free a result we didn't keep.
+//
+// ****************************************************************************
+eavlDataSet *
+ResultCache::Add(const std::string &key, int chunk,
+                 eavlDataSet *ds, bool external)
+{
+    // an importer's parts aren't counted, so they needn't be measured
+    SizeMap sizes;
+    if (!external)
+    {
+        std::vector<eavlArray*> newArrays;
+        std::vector<eavlCellSet*> newCellSets;
+        {
+            QMutexLocker locker(&lock);
+            for (int i=0; i<ds->GetNumFields(); ++i)
+            {
+                eavlArray *arr = ds->GetField(i)->GetArray();
+                if (!parts.count(arr))
+                    newArrays.push_back(arr);
+            }
+            for (int i=0; i<ds->GetNumCellSets(); ++i)
+            {
+                if (!parts.count(ds->GetCellSet(i)))
+                    newCellSets.push_back(ds->GetCellSet(i));
+            }
+        }
+        for (size_t i=0; i<newArrays.size(); ++i)
+            sizes[newArrays[i]] = GetArrayBytes(newArrays[i]);
+        for (size_t i=0; i<newCellSets.size(); ++i)
+            sizes[newCellSets[i]] = GetCellSetBytes(newCellSets[i]);
+    }
+
+    QMutexLocker locker(&lock);
+    Entry e;
+    e.ds = ds;
+    e.external = external;
+    e.lastUse = ++useCounter;
+    std::pair<EntryMap::iterator,bool> ins =
+        entries.insert(std::make_pair(std::make_pair(key, chunk), e));
+    if (ins.second)
+        Reference(ds, external, sizes);
+    else if (ins.first->second.ds != ds)
+        Discard(ds, external);
+    return ins.first->second.ds;
+}
+
+// ****************************************************************************
+// Method:  ResultCache::Trim
+//
+// Purpose:
+///   Evict the least recently used results until the memory we own is
+///   within the budget.  Evicting a result also drops what was derived
+///   from it; if that's still not enough, we drop all of the indexes
+///   and topology, which are rebuilt on demand.  This is only called
+///   while nothing is executing, so nobody is using the indexes; a
+///   topology a proxy is still being built from is freed when the
+///   build releases it.
+///   Data sets read by an importer aren't evicted
+///   for that; they don't hold any memory of ours, and re-reading is
+///   the most expensive thing to redo.  (Generated ones are ours, and
+///   may be.)  But there's one of those for each set of variables ever
+///   read, so past maxExternal of them we evict the least recently
+///   used.  Returns the evicted data sets, which have been freed, so
+///   the caller can forget about them.
+//
+// Arguments:
+//   pinned     data sets which must not be evicted
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 00:21:47 EDT 2026
+//   Generated initial data sets can be evicted too.
+//
+//   Jeremy Meredith, Mon Oct 19 01:31:19 EDT 2026
+//   Evict the oldest results of an importer past maxExternal.
+//
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Count derived indexes, and drop them if we're still over budget.
+//
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   Drop the topology too.
+//
+// ****************************************************************************
+std::set<eavlDataSet*>
+ResultCache::Trim(const std::set<eavlDataSet*> &pinned)
+{
+    QMutexLocker locker(&lock);
+    std::set<eavlDataSet*> evicted;
+    while (used + GetDerivedBytes() > budget)
+    {
+        EntryMap::iterator lru = entries.end();
+        for (EntryMap::iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (it->second.external || pinned.count(it->second.ds))
+                continue;
+            if (lru == entries.end() || it->second.lastUse < lru->second.lastUse)
+                lru = it;
+        }
+        if (lru == entries.end())
+            break;
+        Evict(lru, evicted);
+    }
+    if (used + GetDerivedBytes() > budget)
+    {
+        SpanSpaceIndex::ForgetAll();
+        SortedValueIndex::ForgetAll();
+        TopologyCache::ForgetAll();
+    }
+
+    size_t nexternal = 0;
+    for (EntryMap::iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (it->second.external)
+            ++nexternal;
+    }
+    while (nexternal > maxExternal)
+    {
+        EntryMap::iterator lru = entries.end();
+        for (EntryMap::iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (!it->second.external || pinned.count(it->second.ds))
+                continue;
+            if (lru == entries.end() || it->second.lastUse < lru->second.lastUse)
+                lru = it;
+        }
+        if (lru == entries.end())
+            break;
+        Evict(lru, evicted);
+        --nexternal;
+    }
+    return evicted;
+}
+
+// ****************************************************************************
+// Method:  ResultCache::Evict
+//
+// Purpose:
+///   Remove an entry, and note its data set as evicted if that freed
+///   it.  (The same data set may be the result of more than one key.)
+///   The lock must be held.
+//
+// Arguments:
+//   it         the entry
+//   evicted    (output) the freed data sets
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ResultCache::Evict(EntryMap::iterator it, std::set<eavlDataSet*> &evicted)
+{
+    eavlDataSet *ds = it->second.ds;
+    entries.erase(it);
+    Release(ds);
+    if (!parts.count(ds))
+        evicted.insert(ds);
+}
+
+// ****************************************************************************
+// Method:  ResultCache::SetMemoryBudget
+//
+// Purpose:
+///   Set the number of bytes cached results may hold before Trim
+///   starts evicting them.  Published output is never evicted, so this
+///   is a target, not a hard limit.
+//
+// Arguments:
+//   bytes      the new budget
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ResultCache::SetMemoryBudget(size_t bytes)
+{
+    QMutexLocker locker(&lock);
+    budget = bytes;
+}
+
+size_t
+ResultCache::GetMemoryBudget()
+{
+    QMutexLocker locker(&lock);
+    return budget;
+}
+
+size_t
+ResultCache::GetMemoryUsed()
+{
+    QMutexLocker locker(&lock);
+    return used + GetDerivedBytes();
+}
+
+// ****************************************************************************
+// Method:  ResultCache::AddDerivedBytes
+//
+// Purpose:
+///   Count memory a cache holds for something derived from our results
+///   (an index or topology), so it's part of the budget.  The caches
+///   call this under their own locks, and may do so under ours (from
+///   ForgetDerived), so it has a lock of its own, taken last.
+//
+// Arguments:
+//   bytes      the memory added
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ResultCache::AddDerivedBytes(size_t bytes)
+{
+    QMutexLocker locker(&derivedLock);
+    derived += bytes;
+}
+
+void
+ResultCache::RemoveDerivedBytes(size_t bytes)
+{
+    QMutexLocker locker(&derivedLock);
+    derived -= std::min(bytes, derived);
+}
+
+size_t
+ResultCache::GetDerivedBytes()
+{
+    QMutexLocker locker(&derivedLock);
+    return derived;
+}
+
+// ****************************************************************************
+// Method:  ResultCache::GetDataSetBytes
+//
+// Purpose:
+///   The memory held by a data set's arrays and cell sets, measured the
+///   same way as for the cache, whether or not it's cached.
+//
+// Arguments:
+//   ds         the data set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+size_t
+ResultCache::GetDataSetBytes(eavlDataSet *ds)
+{
+    size_t bytes = 0;
+    for (int i=0; i<ds->GetNumFields(); ++i)
+        bytes += GetArrayBytes(ds->GetField(i)->GetArray());
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+        bytes += GetCellSetBytes(ds->GetCellSet(i));
+    return bytes;
+}
+
+// ****************************************************************************
+// Method:  ResultCache::RetainParts
+//
+// Purpose:
+///   Count a reference to each field, array, and cell set of a data
+///   set, so they aren't freed while something outside the cache (e.g.
+///   a build in the background) reads them, even if every result using
+///   them is evicted.  The data set structure isn't counted; it should
+///   be the caller's own shallow copy.  If any of them isn't a part of
+///   a cached data set, nothing is counted and we return false.
+//
+// Arguments:
+//   ds         the data set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+bool
+ResultCache::RetainParts(eavlDataSet *ds)
+{
+    QMutexLocker locker(&lock);
+    for (int i=0; i<ds->GetNumFields(); ++i)
+    {
+        if (!parts.count(ds->GetField(i)) ||
+            !parts.count(ds->GetField(i)->GetArray()))
+            return false;
+    }
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+    {
+        if (!parts.count(ds->GetCellSet(i)))
+            return false;
+    }
+
+    for (int i=0; i<ds->GetNumFields(); ++i)
+    {
+        parts[ds->GetField(i)].refs++;
+        parts[ds->GetField(i)->GetArray()].refs++;
+    }
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+        parts[ds->GetCellSet(i)].refs++;
+    return true;
+}
+
+// ****************************************************************************
+// Method:  ResultCache::ReleaseParts
+//
+// Purpose:
+///   Drop the references RetainParts counted, freeing whatever nothing
+///   in the cache uses any more.  Nothing in the cache uses those, so
+///   no executing pipeline can be reading them.  The data set structure
+///   is left to the caller.
+//
+// Arguments:
+//   ds         the data set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ResultCache::ReleaseParts(eavlDataSet *ds)
+{
+    QMutexLocker locker(&lock);
+    for (int i=0; i<ds->GetNumFields(); ++i)
+    {
+        eavlField *f = ds->GetField(i);
+        eavlArray *arr = f->GetArray();
+        ReleasePart(f);
+        ReleasePart(arr);
+    }
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+        ReleasePart(ds->GetCellSet(i));
+}
+
+// ****************************************************************************
+// Method:  ResultCache::ForgetDerived
+//
+// Purpose:
+///   Tell everything which keeps information derived from a part of a
+///   data set (indexes, stats, external faces, and whatever registered
+///   a hook) to forget it.  We do this before freeing a part; it's also
+///   public, so e.g. a benchmark can start each repetition cold.
+//
+// Arguments:
+//   part       the data set, field, array, or cell set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ResultCache::ForgetDerived(void *part)
+{
+    SpanSpaceIndex::Forget(part);
+    SortedValueIndex::Forget(part);
+    ExternalFaceCache::Forget(part);
+    TopologyCache::Forget(part);
+    FieldStatsCache::Forget(static_cast<eavlArray*>(part));
+    std::vector<ForgetHook> &hooks = GetForgetHooks();
+    for (size_t i=0; i<hooks.size(); ++i)
+        hooks[i](part);
+}
+
+// ****************************************************************************
+// Method:  ResultCache::AddForgetHook
+//
+// Purpose:
+///   Register a function for ForgetDerived to call, for a cache which
+///   isn't part of the pipeline engine (e.g. rendering proxies), so the
+///   engine doesn't depend on it.  Call this during static
+///   initialization; it returns true so it can initialize a static.
+//
+// Arguments:
+//   hook       the function to call with each part about to be freed
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+bool
+ResultCache::AddForgetHook(ForgetHook hook)
+{
+    GetForgetHooks().push_back(hook);
+    return true;
+}
+
+// ****************************************************************************
+// Method:  ResultCache::GetForgetHooks
+//
+// Purpose:
+///   The registered hooks.  This is a function so the list exists
+///   before any other file's static initialization uses it.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::vector<ResultCache::ForgetHook> &
+ResultCache::GetForgetHooks()
+{
+    static std::vector<ForgetHook> hooks;
+    return hooks;
+}
+
+// ****************************************************************************
+// Method:  ResultCache::Reference
+//
+// Purpose:
+///   Count a reference to a newly cached data set, and from it to each
+///   of its fields, arrays, and cell sets.  The lock must be held.
+///
+///   The data set structure itself is always ours, even for what an
+///   importer read (see Pipeline::ExecuteChunk).  Coordinate systems
+///   aren't counted: a copied one shares its axes with the original
+///   (see CopyCoordinates), so we can't safely free them, and they're
+///   tiny.
+//
+// Arguments:
+//   ds         the data set
+//   external   true if its parts, when new to us, belong to an importer
+//   sizes      the sizes of new parts, if already measured
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:31:19 EDT 2026
+//   Count the data set and field structures, too.
+//
+// ****************************************************************************
+void
+ResultCache::Reference(eavlDataSet *ds, bool external, const SizeMap &sizes)
+{
+    ReferencePart(ds, DataSetPart, false, sizes);
+    for (int i=0; i<ds->GetNumFields(); ++i)
+    {
+        ReferencePart(ds->GetField(i), FieldPart, external, sizes);
+        ReferencePart(ds->GetField(i)->GetArray(), ArrayPart, external, sizes);
+    }
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+        ReferencePart(ds->GetCellSet(i), CellSetPart, external, sizes);
+}
+
+// ****************************************************************************
+// Method:  ResultCache::Release
+//
+// Purpose:
+///   Drop the references of an evicted data set, freeing whatever
+///   nothing else in the cache uses, possibly including the data set
+///   itself.  The lock must be held.
+//
+// Arguments:
+//   ds         the data set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:31:19 EDT 2026
+//   Release the data set and field structures, too.
+//
+// ****************************************************************************
+void
+ResultCache::Release(eavlDataSet *ds)
+{
+    for (int i=0; i<ds->GetNumFields(); ++i)
+    {
+        eavlField *f = ds->GetField(i);
+        eavlArray *arr = f->GetArray();
+        ReleasePart(f);
+        ReleasePart(arr);
+    }
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+        ReleasePart(ds->GetCellSet(i));
+    ReleasePart(ds);
+}
+
+// ****************************************************************************
+// Method:  ResultCache::Discard
+//
+// Purpose:
+///   Free a result we didn't keep, and whatever of it the cache doesn't
+///   know about.  The lock must be held.
+//
+// Arguments:
+//   ds         the data set
+//   external   true if its parts belong to an importer
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ResultCache::Discard(eavlDataSet *ds, bool external)
+{
+    if (parts.count(ds))
+        return;
+    if (!external)
+    {
+        for (int i=0; i<ds->GetNumFields(); ++i)
+        {
+            eavlField *f = ds->GetField(i);
+            if (!parts.count(f->GetArray()))
+                delete f->GetArray();
+            if (!parts.count(f))
+                DeleteFieldShell(f);
+        }
+        for (int i=0; i<ds->GetNumCellSets(); ++i)
+        {
+            if (!parts.count(ds->GetCellSet(i)))
+                delete ds->GetCellSet(i);
+        }
+    }
+    DeleteDataSetShell(ds);
+}
+
+// ****************************************************************************
+// Method:  ResultCache::ReferencePart
+//
+// Purpose:
+///   Count one more reference to a part of a data set.  The first time
+///   we see an array or cell set of ours, we count its memory, measuring
+///   it if the caller hasn't.  The lock must be held.
+//
+// Arguments:
+//   p          the part
+//   type       what kind of part it is
+//   external   true if it belongs to an importer
+//   sizes      the sizes of new parts, if already measured
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:31:19 EDT 2026
+//   Added the other kinds of parts, and the sizes measured outside
+//   the lock.  An importer's parts aren't measured at all.
+//
+// ****************************************************************************
+void
+ResultCache::ReferencePart(void *p, PartType type, bool external,
+                           const SizeMap &sizes)
+{
+    std::map<void*, Part>::iterator it = parts.find(p);
+    if (it != parts.end())
+    {
+        it->second.refs++;
+        return;
+    }
+
+    Part part;
+    part.refs = 1;
+    part.type = type;
+    part.external = external;
+    part.bytes = 0;
+    if (!external && (type == ArrayPart || type == CellSetPart))
+    {
+        SizeMap::const_iterator s = sizes.find(p);
+        if (s != sizes.end())
+            part.bytes = s->second;
+        else if (type == ArrayPart)
+            part.bytes = GetArrayBytes(static_cast<eavlArray*>(p));
+        else
+            part.bytes = GetCellSetBytes(static_cast<eavlCellSet*>(p));
+    }
+    used += part.bytes;
+    parts[p] = part;
+}
+
+// ****************************************************************************
+// Method:  ResultCache::ReleasePart
+//
+// Purpose:
+///   Drop a reference to a part of a data set, and free it when it
+///   has none left (unless it belongs to an importer).  Either way,
+///   what the caches derived from it is forgotten.  The lock must
+///   be held.
+//
+// Arguments:
+//   p          the part
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 21:17:52 EDT 2026
+//   Forget a freed array's field stats.
+//
+//   Jeremy Meredith, Sun Oct 18 22:08:14 EDT 2026
+//   Forget any span space index using a freed array or cell set.
+//
+//   Jeremy Meredith, Sun Oct 18 22:54:06 EDT 2026
+//   Forget any sorted value index, too.
+//
+//   Jeremy Meredith, Sun Oct 18 23:16:40 EDT 2026
+//   And any cached external faces.
+//
+//   Jeremy Meredith, Sun Oct 18 23:34:12 EDT 2026
+//   And any cached topology.
+//
+//   Jeremy Meredith, Mon Oct 19 01:14:37 EDT 2026
+//   And any rendering proxy.
+//
+//   Jeremy Meredith, Mon Oct 19 01:31:19 EDT 2026
+//   Free data set and field structures, without what they point to.
+//   A proxy is also forgotten with the data set it was made for.
+//
+//   Jeremy Meredith, Mon Oct 19 01:40:17 EDT 2026
+//   Use ForgetDerived.
+//
+//   Jeremy Meredith, Mon Oct 19 01:44:03 EDT 2026
+//   Forget what was derived from an importer's part, too, when we
+//   stop using it; the importer may reuse the memory.
+//
+// ****************************************************************************
+void
+ResultCache::ReleasePart(void *p)
+{
+    std::map<void*, Part>::iterator it = parts.find(p);
+    if (it == parts.end())
+        return;
+    if (--it->second.refs > 0)
+        return;
+
+    ForgetDerived(p);
+    if (!it->second.external)
+    {
+        used -= it->second.bytes;
+        switch (it->second.type)
+        {
+          case ArrayPart:
+            delete static_cast<eavlArray*>(p);
+            break;
+          case CellSetPart:
+            delete static_cast<eavlCellSet*>(p);
+            break;
+          case FieldPart:
+            DeleteFieldShell(static_cast<eavlField*>(p));
+            break;
+          case DataSetPart:
+            DeleteDataSetShell(static_cast<eavlDataSet*>(p));
+            break;
+        }
+    }
+    parts.erase(it);
+}
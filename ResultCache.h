@@ -0,0 +1,131 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include <QMutex>
+#include <set>
+
+// ****************************************************************************
+// Class:  ResultCache
+//
+// Purpose:
+///   Process-wide cache of pipeline results, so pipelines which share a
+///   source and a prefix of operations (with the same settings) share
+///   the work and the memory.  Keys are built by the pipelines (see
+///   Pipeline::GetStageKeys), and each key has one data set per chunk.
+///   Cached data sets are never changed in place once they're added.
+///   This may be called from any thread.
+///
+///   The cache also owns the memory of the results.  Consecutive stages
+///   share most of their arrays, cell sets, and field and data set
+///   structures, so we count references to each of those across all
+///   cached data sets, and only count (and free) each one once.  Parts
+///   of initial data sets came from an importer, which may hold on to
+///   them, so those are never freed.  When the parts we own go over the
+///   memory budget, Trim evicts the least recently used results.
+///   Results of an importer free nothing of ours, so they're only
+///   evicted when there are too many of them (e.g. one for each set of
+///   variables read).
+///
+///   Indexes and topology derived from the results count against the
+///   same budget (see AddDerivedBytes), and are dropped by Trim when
+///   evicting results isn't enough.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 17:45:50 EDT 2026
+//   Added the memory budget, accounting, and eviction.
+//
+//   Jeremy Meredith, Sun Oct 18 20:48:13 EDT 2026
+//   Added GetDataSetBytes.
+//
+//   Jeremy Meredith, Mon Oct 19 01:31:19 EDT 2026
+//   Own the data set and field structures too.  Evict results of an
+//   importer past a count.  Measure new parts outside the lock.
+//
+//   Jeremy Meredith, Mon Oct 19 01:40:17 EDT 2026
+//   Added ForgetDerived, and hooks for caches outside the pipeline
+//   engine to be told about freed parts.
+//
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Count derived indexes and topology against the budget.
+//
+//   Jeremy Meredith, Mon Oct 19 02:17:52 EDT 2026
+//   Added RetainParts and ReleaseParts, for work in the background.
+//
+//   Jeremy Meredith, Mon Oct 19 03:09:21 EDT 2026
+//   Removed Clear, which nothing used, and which left the derived
+//   caches keyed on parts it dropped without freeing.
+//
+// ****************************************************************************
+class ResultCache
+{
+  public:
+    typedef void (*ForgetHook)(void *part);
+
+  protected:
+    struct Entry
+    {
+        eavlDataSet   *ds;
+        bool           external;
+        unsigned long  lastUse;
+    };
+    enum PartType { ArrayPart, CellSetPart, FieldPart, DataSetPart };
+    struct Part
+    {
+        int       refs;
+        PartType  type;
+        bool      external;
+        size_t    bytes;
+    };
+    typedef std::map<std::pair<std::string,int>, Entry> EntryMap;
+    typedef std::map<void*, size_t> SizeMap;
+
+    static QMutex                lock;
+    static EntryMap              entries;
+    static std::map<void*, Part> parts;
+    static size_t                budget;
+    static size_t                used;
+    static size_t                maxExternal;
+    static unsigned long         useCounter;
+    static QMutex                derivedLock;
+    static size_t                derived;
+
+  public:
+    static eavlDataSet *Find(const std::string &key, int chunk);
+    static eavlDataSet *Add(const std::string &key, int chunk,
+                            eavlDataSet *ds, bool external);
+    static std::set<eavlDataSet*> Trim(const std::set<eavlDataSet*> &pinned);
+
+    static void         SetMemoryBudget(size_t bytes);
+    static size_t       GetMemoryBudget();
+    static size_t       GetMemoryUsed();
+
+    static size_t       GetDataSetBytes(eavlDataSet *ds);
+    static bool         RetainParts(eavlDataSet *ds);
+    static void         ReleaseParts(eavlDataSet *ds);
+
+    static void         ForgetDerived(void *part);
+    static bool         AddForgetHook(ForgetHook hook);
+    static void         AddDerivedBytes(size_t bytes);
+    static void         RemoveDerivedBytes(size_t bytes);
+
+  protected:
+    static std::vector<ForgetHook> &GetForgetHooks();
+    static size_t       GetDerivedBytes();
+    static void         Reference(eavlDataSet *ds, bool external,
+                                  const SizeMap &sizes);
+    static void         Release(eavlDataSet *ds);
+    static void         Discard(eavlDataSet *ds, bool external);
+    static void         ReferencePart(void *p, PartType type, bool external,
+                                      const SizeMap &sizes);
+    static void         ReleasePart(void *p);
+    static void         Evict(EntryMap::iterator it,
+                              std::set<eavlDataSet*> &evicted);
+};
+
+#endif
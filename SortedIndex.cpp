@@ -0,0 +1,226 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "SortedIndex.h"
+#include "ResultCache.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+
+QMutex                                   SortedValueIndex::lock;
+std::map<eavlArray*,SortedValueIndex*>   SortedValueIndex::indices;
+
+// ****************************************************************************
+// Struct:  ValueLess
+//
+// Purpose:
+///   Orders tuple indices by their values, for sorting.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct ValueLess
+{
+    const std::vector<float> *vals;
+    bool operator()(int a, int b) const
+    {
+        return (*vals)[a] < (*vals)[b];
+    }
+};
+
+// ****************************************************************************
+// Constructor:  SortedValueIndex::SortedValueIndex
+//
+// Purpose:
+///   Build the index by sorting the tuple indices by value.
+//
+// Arguments:
+//   arr        the array; we use its first component
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+SortedValueIndex::SortedValueIndex(eavlArray *arr)
+    : ntuples(arr->GetNumberOfTuples())
+{
+    std::vector<float> unsorted(ntuples);
+    eavlFloatArray *farr = dynamic_cast<eavlFloatArray*>(arr);
+    if (farr)
+    {
+        const float *vals = (const float*)farr->GetHostArray();
+        int ncomp = farr->GetNumberOfComponents();
+        for (int i=0; i<ntuples; ++i)
+            unsorted[i] = vals[long(i)*ncomp];
+    }
+    else
+    {
+        for (int i=0; i<ntuples; ++i)
+            unsorted[i] = arr->GetComponentAsDouble(i, 0);
+    }
+
+    tuples.resize(ntuples);
+    for (int i=0; i<ntuples; ++i)
+        tuples[i] = i;
+    ValueLess less;
+    less.vals = &unsorted;
+    std::sort(tuples.begin(), tuples.end(), less);
+
+    values.resize(ntuples);
+    for (int i=0; i<ntuples; ++i)
+        values[i] = unsorted[tuples[i]];
+}
+
+// ****************************************************************************
+// Method:  SortedValueIndex::GetTuplesInRange
+//
+// Purpose:
+///   Find the tuples whose value is within a range, in increasing order.
+//
+// Arguments:
+//   minval     the low end of the range
+//   maxval     the high end of the range
+//   result     (output) the tuple indices
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+SortedValueIndex::GetTuplesInRange(float minval, float maxval,
+                                   std::vector<int> &result) const
+{
+    result.clear();
+    if (minval > maxval)
+        return;
+
+    int begin = std::lower_bound(values.begin(), values.end(), minval) -
+                values.begin();
+    int end = std::upper_bound(values.begin(), values.end(), maxval) -
+              values.begin();
+    result.assign(tuples.begin() + begin, tuples.begin() + end);
+
+    // keep the output in the same order as a full pass would
+    std::sort(result.begin(), result.end());
+}
+
+// ****************************************************************************
+// Method:  SortedValueIndex::GetMemoryBytes
+//
+// Purpose:
+///   The memory used by this index.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+size_t
+SortedValueIndex::GetMemoryBytes() const
+{
+    return values.size() * sizeof(float) + tuples.size() * sizeof(int);
+}
+
+// ****************************************************************************
+// Method:  SortedValueIndex::Get
+//
+// Purpose:
+///   Get the index for an array, building it if we haven't yet.  Two
+///   threads asking for the same new index at once may both build it;
+///   one of them is thrown away.
+//
+// Arguments:
+//   arr        the array
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Count the memory of a new index.  Don't compare sizes to catch a
+//   reused address; we're told to forget before anything is freed.
+//
+// ****************************************************************************
+SortedValueIndex *
+SortedValueIndex::Get(eavlArray *arr)
+{
+    {
+        QMutexLocker locker(&lock);
+        std::map<eavlArray*,SortedValueIndex*>::iterator it = indices.find(arr);
+        if (it != indices.end())
+            return it->second;
+    }
+
+    // don't hold the lock while we build
+    SortedValueIndex *index = new SortedValueIndex(arr);
+
+    QMutexLocker locker(&lock);
+    SortedValueIndex *&entry = indices[arr];
+    if (entry)
+    {
+        delete index;
+        return entry;
+    }
+    entry = index;
+    ResultCache::AddDerivedBytes(index->GetMemoryBytes());
+    return index;
+}
+
+// ****************************************************************************
+// Method:  SortedValueIndex::Forget
+//
+// Purpose:
+///   Free the index for an array which is about to be freed.  This is
+///   only called while nothing is executing.
+//
+// Arguments:
+//   part       the array (or a cell set, which we ignore)
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Stop counting the memory of what we free.
+//
+// ****************************************************************************
+void
+SortedValueIndex::Forget(void *part)
+{
+    QMutexLocker locker(&lock);
+    std::map<eavlArray*,SortedValueIndex*>::iterator it =
+        indices.find(static_cast<eavlArray*>(part));
+    if (it == indices.end())
+        return;
+    ResultCache::RemoveDerivedBytes(it->second->GetMemoryBytes());
+    delete it->second;
+    indices.erase(it);
+}
+
+// ****************************************************************************
+// Method:  SortedValueIndex::ForgetAll
+//
+// Purpose:
+///   Free every index, for the ResultCache to get back under its
+///   budget.  This is only called while nothing is executing.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+SortedValueIndex::ForgetAll()
+{
+    QMutexLocker locker(&lock);
+    std::map<eavlArray*,SortedValueIndex*>::iterator it;
+    for (it = indices.begin(); it != indices.end(); ++it)
+    {
+        ResultCache::RemoveDerivedBytes(it->second->GetMemoryBytes());
+        delete it->second;
+    }
+    indices.clear();
+}
@@ -0,0 +1,53 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef SORTED_INDEX_H
+#define SORTED_INDEX_H
+
+#include "STL.h"
+#include "eavlArray.h"
+#include <QMutex>
+
+// ****************************************************************************
+// Class:  SortedValueIndex
+//
+// Purpose:
+///   The tuples of an array (e.g. a cell field) sorted by the value of
+///   their first component, so the tuples with values in a range are
+///   found with two binary searches, and come out as one run.
+///
+///   Get builds an index the first time it's asked for one and keeps it
+///   until the ResultCache lets go of the array (see Forget) or needs
+///   the memory (see ForgetAll), just like the SpanSpaceIndex does for
+///   nodal fields.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Count our memory in the ResultCache budget, and added ForgetAll.
+//   Rely on Forget for reused addresses instead of comparing sizes.
+//
+// ****************************************************************************
+class SortedValueIndex
+{
+  protected:
+    int                 ntuples;
+    std::vector<float>  values;
+    std::vector<int>    tuples;
+
+    static QMutex                                 lock;
+    static std::map<eavlArray*,SortedValueIndex*> indices;
+
+  public:
+    SortedValueIndex(eavlArray *arr);
+
+    void   GetTuplesInRange(float minval, float maxval,
+                            std::vector<int> &result) const;
+    size_t GetMemoryBytes() const;
+
+    static SortedValueIndex *Get(eavlArray *arr);
+    static void              Forget(void *part);
+    static void              ForgetAll();
+};
+
+#endif
@@ -0,0 +1,491 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "SpanSpace.h"
+#include "ResultCache.h"
+
+#include <eavlCellSetExplicit.h>
+
+#include <QMutexLocker>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <cfloat>
+
+QMutex                                                  SpanSpaceIndex::lock;
+std::map<SpanSpaceIndex::Key,SpanSpaceIndex*>           SpanSpaceIndex::indices;
+
+/// Cells per piece of work when finding the cell ranges.
+static const int spanBlockSize = 1 << 16;
+
+/// Bins along each axis of span space.
+static const int spanBins = 64;
+
+// ****************************************************************************
+// Struct:  CellRanges
+//
+// Purpose:
+///   Function object for QtConcurrent finding the range of the field
+///   over each cell in one block of cells.  The values are read directly
+///   from float arrays since that's nearly always what we have.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct CellRanges
+{
+    typedef void result_type;
+
+    eavlCellSet  *cs;
+    eavlArray    *arr;
+    const float  *vals;
+    int           ncomp;
+    int           ncells;
+    float        *mins;
+    float        *maxs;
+
+    void operator()(int &block)
+    {
+        int begin = block * spanBlockSize;
+        int end = std::min(begin + spanBlockSize, ncells);
+        for (int i=begin; i<end; ++i)
+        {
+            eavlCell cell = cs->GetCellNodes(i);
+            float cmin = FLT_MAX, cmax = -FLT_MAX;
+            for (int j=0; j<cell.numIndices; ++j)
+            {
+                int p = cell.indices[j];
+                float v = vals ? vals[long(p)*ncomp]
+                               : float(arr->GetComponentAsDouble(p, 0));
+                if (v < cmin)
+                    cmin = v;
+                if (v > cmax)
+                    cmax = v;
+            }
+            mins[i] = cmin;
+            maxs[i] = cmax;
+        }
+    }
+};
+
+// ****************************************************************************
+// Constructor:  SpanSpaceIndex::SpanSpaceIndex
+//
+// Purpose:
+///   Build the index: find each cell's range in parallel, then sort the
+///   cells into buckets with a counting sort.
+//
+// Arguments:
+//   cs         the cell set
+//   arr        the nodal field's array; we use its first component
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+SpanSpaceIndex::SpanSpaceIndex(eavlCellSet *cs, eavlArray *arr)
+    : ncells(cs->GetNumCells()), ntuples(arr->GetNumberOfTuples()),
+      nbins(spanBins), lo(0), hi(0)
+{
+    std::vector<float> mins(ncells), maxs(ncells);
+
+    CellRanges ranges;
+    ranges.cs = cs;
+    ranges.arr = arr;
+    ranges.vals = NULL;
+    ranges.ncomp = arr->GetNumberOfComponents();
+    ranges.ncells = ncells;
+    ranges.mins = mins.empty() ? NULL : &mins[0];
+    ranges.maxs = maxs.empty() ? NULL : &maxs[0];
+    // make sure the values are on the host before the threads start
+    if (dynamic_cast<eavlFloatArray*>(arr))
+        ranges.vals = (const float*)arr->GetHostArray();
+
+    std::vector<int> blocks;
+    for (int b=0; b*spanBlockSize < ncells; ++b)
+        blocks.push_back(b);
+    QtConcurrent::blockingMap(blocks, ranges);
+
+    if (ncells > 0)
+    {
+        lo = *std::min_element(mins.begin(), mins.end());
+        hi = *std::max_element(maxs.begin(), maxs.end());
+    }
+
+    // counting sort into buckets
+    std::vector<int> bucket(ncells);
+    binStart.resize(nbins*nbins + 1, 0);
+    for (int i=0; i<ncells; ++i)
+    {
+        bucket[i] = GetBin(mins[i]) * nbins + GetBin(maxs[i]);
+        binStart[bucket[i]+1]++;
+    }
+    for (int b=0; b<nbins*nbins; ++b)
+        binStart[b+1] += binStart[b];
+
+    std::vector<int> next(binStart.begin(), binStart.end()-1);
+    cells.resize(ncells);
+    cellMin.resize(ncells);
+    cellMax.resize(ncells);
+    for (int i=0; i<ncells; ++i)
+    {
+        int pos = next[bucket[i]]++;
+        cells[pos] = i;
+        cellMin[pos] = mins[i];
+        cellMax[pos] = maxs[i];
+    }
+}
+
+// ****************************************************************************
+// Method:  SpanSpaceIndex::GetBin
+//
+// Purpose:
+///   The bin along either axis of span space holding a value.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+int
+SpanSpaceIndex::GetBin(float v) const
+{
+    if (!(hi > lo))
+        return 0;
+    int b = int(double(v - lo) / double(hi - lo) * nbins);
+    return std::max(0, std::min(nbins-1, b));
+}
+
+// ****************************************************************************
+// Method:  SpanSpaceIndex::GetActiveCells
+//
+// Purpose:
+///   Find the cells whose range includes a value, in increasing order.
+//
+// Arguments:
+//   value      the isovalue
+//   active     (output) the cell indices
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:54:06 EDT 2026
+//   Moved the search to GetCellsInRange.
+//
+// ****************************************************************************
+void
+SpanSpaceIndex::GetActiveCells(float value, std::vector<int> &active) const
+{
+    GetCellsInRange(value, value, false, active);
+}
+
+// ****************************************************************************
+// Method:  SpanSpaceIndex::GetCellsInRange
+//
+// Purpose:
+///   Find the cells whose range overlaps a range of values, or with
+///   "contained", the cells whose range is inside it.  Either way, the
+///   buckets strictly inside the answer are taken whole, and only the
+///   ones on its edges have their cells tested.  The cells come out in
+///   increasing order.
+//
+// Arguments:
+//   minval     the low end of the range
+//   maxval     the high end of the range
+//   contained  true to require the whole cell range to be inside
+//   result     (output) the cell indices
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+SpanSpaceIndex::GetCellsInRange(float minval, float maxval, bool contained,
+                                std::vector<int> &result) const
+{
+    result.clear();
+    if (ncells == 0 || maxval < lo || minval > hi || minval > maxval)
+        return;
+
+    // GetBin never decreases as the value increases, so e.g. a cell
+    // whose min bin is below bmax has a min below maxval
+    int bmin = GetBin(minval);
+    int bmax = GetBin(maxval);
+    for (int minb = 0; minb < nbins; ++minb)
+    {
+        for (int maxb = minb; maxb < nbins; ++maxb)
+        {
+            bool whole;
+            if (contained)
+            {
+                if (minb < bmin || maxb > bmax)
+                    continue;
+                whole = (minb > bmin && maxb < bmax);
+            }
+            else
+            {
+                if (minb > bmax || maxb < bmin)
+                    continue;
+                whole = (minb < bmax && maxb > bmin);
+            }
+
+            int b = minb * nbins + maxb;
+            int begin = binStart[b], end = binStart[b+1];
+            if (whole)
+            {
+                result.insert(result.end(),
+                              cells.begin() + begin, cells.begin() + end);
+            }
+            else if (contained)
+            {
+                for (int i=begin; i<end; ++i)
+                {
+                    if (minval <= cellMin[i] && cellMax[i] <= maxval)
+                        result.push_back(cells[i]);
+                }
+            }
+            else
+            {
+                for (int i=begin; i<end; ++i)
+                {
+                    if (cellMin[i] <= maxval && minval <= cellMax[i])
+                        result.push_back(cells[i]);
+                }
+            }
+        }
+    }
+
+    // keep the output in the same order as a full pass would
+    std::sort(result.begin(), result.end());
+}
+
+// ****************************************************************************
+// Method:  SpanSpaceIndex::GetMemoryBytes
+//
+// Purpose:
+///   The memory used by this index.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+size_t
+SpanSpaceIndex::GetMemoryBytes() const
+{
+    return binStart.size() * sizeof(int) +
+           cells.size() * sizeof(int) +
+           (cellMin.size() + cellMax.size()) * sizeof(float);
+}
+
+// ****************************************************************************
+// Method:  SpanSpaceIndex::Get
+//
+// Purpose:
+///   Get the index for a cell set and nodal field, building it if we
+///   haven't yet.  Two threads asking for the same new index at once
+///   may both build it; one of them is thrown away.
+//
+// Arguments:
+//   cs         the cell set
+//   arr        the nodal field's array
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Count the memory of a new index.  Don't compare sizes to catch a
+//   reused address; we're told to forget before anything is freed.
+//
+// ****************************************************************************
+SpanSpaceIndex *
+SpanSpaceIndex::Get(eavlCellSet *cs, eavlArray *arr)
+{
+    Key key(cs, arr);
+    {
+        QMutexLocker locker(&lock);
+        std::map<Key,SpanSpaceIndex*>::iterator it = indices.find(key);
+        if (it != indices.end())
+            return it->second;
+    }
+
+    // don't hold the lock while we build
+    SpanSpaceIndex *index = new SpanSpaceIndex(cs, arr);
+
+    QMutexLocker locker(&lock);
+    SpanSpaceIndex *&entry = indices[key];
+    if (entry)
+    {
+        delete index;
+        return entry;
+    }
+    entry = index;
+    ResultCache::AddDerivedBytes(index->GetMemoryBytes());
+    return index;
+}
+
+// ****************************************************************************
+// Method:  SpanSpaceIndex::Forget
+//
+// Purpose:
+///   Free the indices using a cell set or array which is about to be
+///   freed.  This is only called while nothing is executing.
+//
+// Arguments:
+//   part       the cell set or array
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Stop counting the memory of what we free.
+//
+// ****************************************************************************
+void
+SpanSpaceIndex::Forget(void *part)
+{
+    QMutexLocker locker(&lock);
+    std::map<Key,SpanSpaceIndex*>::iterator it = indices.begin();
+    while (it != indices.end())
+    {
+        if ((void*)it->first.first == part || (void*)it->first.second == part)
+        {
+            ResultCache::RemoveDerivedBytes(it->second->GetMemoryBytes());
+            delete it->second;
+            indices.erase(it++);
+        }
+        else
+            ++it;
+    }
+}
+
+// ****************************************************************************
+// Method:  SpanSpaceIndex::ForgetAll
+//
+// Purpose:
+///   Free every index, for the ResultCache to get back under its
+///   budget.  This is only called while nothing is executing.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+SpanSpaceIndex::ForgetAll()
+{
+    QMutexLocker locker(&lock);
+    std::map<Key,SpanSpaceIndex*>::iterator it;
+    for (it = indices.begin(); it != indices.end(); ++it)
+    {
+        ResultCache::RemoveDerivedBytes(it->second->GetMemoryBytes());
+        delete it->second;
+    }
+    indices.clear();
+}
+
+// ****************************************************************************
+// Function:  CreateCellSubset
+//
+// Purpose:
+///   Create a data set with only some of the cells of a cell set, for
+///   handing to a filter which should only look at those cells.  The
+///   points, coordinates, and nodal fields are shared with the original;
+///   the cell set (which keeps its name) and its cell fields are new.
+///   Fields on other cell sets are left out.  Free it with FreeCellSubset.
+//
+// Arguments:
+//   ds         the data set
+//   cs         one of its cell sets
+//   cells      the indices of the cells to keep
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlDataSet *
+CreateCellSubset(eavlDataSet *ds, eavlCellSet *cs, const std::vector<int> &cells)
+{
+    eavlExplicitConnectivity conn;
+    for (size_t i=0; i<cells.size(); ++i)
+    {
+        eavlCell cell = cs->GetCellNodes(cells[i]);
+        conn.AddElement(cell.type, cell.numIndices, cell.indices);
+    }
+    eavlCellSetExplicit *subset = new eavlCellSetExplicit(cs->GetName(),
+                                                          cs->GetDimensionality());
+    subset->SetCellNodeConnectivity(conn);
+
+    eavlDataSet *out = new eavlDataSet;
+    out->SetNumPoints(ds->GetNumPoints());
+    out->SetLogicalStructure(ds->GetLogicalStructure());
+    for (int i=0; i<ds->GetNumCoordinateSystems(); ++i)
+        out->AddCoordinateSystem(ds->GetCoordinateSystem(i));
+    out->AddCellSet(subset);
+
+    for (int i=0; i<ds->GetNumFields(); ++i)
+    {
+        eavlField *f = ds->GetField(i);
+        if (f->GetAssociation() != eavlField::ASSOC_CELL_SET)
+        {
+            out->AddField(f);
+            continue;
+        }
+        if (f->GetAssocCellSet() != cs->GetName())
+            continue;
+
+        eavlArray *arr = f->GetArray();
+        int nc = arr->GetNumberOfComponents();
+        eavlFloatArray *sub = new eavlFloatArray(arr->GetName(), nc,
+                                                 cells.size());
+        for (size_t j=0; j<cells.size(); ++j)
+            for (int c=0; c<nc; ++c)
+                sub->SetComponentFromDouble(j, c,
+                                  arr->GetComponentAsDouble(cells[j], c));
+        out->AddField(new eavlField(f->GetOrder(), sub,
+                                    eavlField::ASSOC_CELL_SET,
+                                    cs->GetName()));
+    }
+    return out;
+}
+
+// ****************************************************************************
+// Function:  FreeCellSubset
+//
+// Purpose:
+///   Free what CreateCellSubset made, but not what it shares, nor
+///   anything a mutator has added to it since.
+//
+// Arguments:
+//   subset     the data set from CreateCellSubset
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:54:06 EDT 2026
+//   Leave alone whatever a mutator added.
+//
+// ****************************************************************************
+void
+FreeCellSubset(eavlDataSet *subset)
+{
+    eavlCellSet *cs = subset->GetCellSet(0);
+    for (int i=0; i<subset->GetNumFields(); ++i)
+    {
+        eavlField *f = subset->GetField(i);
+        if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+            f->GetAssocCellSet() == cs->GetName())
+        {
+            delete f->GetArray();
+            delete f;
+        }
+    }
+    delete cs;
+}
@@ -0,0 +1,88 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef SPAN_SPACE_H
+#define SPAN_SPACE_H
+
+#include "STL.h"
+#include "eavlArray.h"
+#include "eavlCellSet.h"
+#include "eavlDataSet.h"
+#include <QMutex>
+
+// ****************************************************************************
+// Class:  SpanSpaceIndex
+//
+// Purpose:
+///   An index of the cells of a cell set by the range of a nodal field
+///   over each cell's points, for finding the cells an isosurface passes
+///   through without looking at the rest.
+///
+///   Each cell's (min,max) is a point in "span space".  We divide the
+///   field's range into bins and sort the cells into a 2D grid of
+///   (min bin, max bin) buckets.  For a value in bin b, a bucket with
+///   min bin < b and max bin > b holds only cells which contain the
+///   value, so those are taken whole; only the buckets on the row and
+///   column of b need each cell tested, and every other bucket is
+///   skipped.  This costs three words per cell.  Ranges of values
+///   (e.g. for a threshold) work the same way.
+///
+///   Get builds an index the first time it's asked for one and keeps it
+///   until the ResultCache lets go of the cell set or array (see
+///   Forget), or needs the memory (see ForgetAll); like FieldStatsCache,
+///   this relies on pipeline results never changing once computed.  The
+///   cache tells us before it drops any part, even an importer's, so an
+///   address can't be reused while we still have an index keyed by it.
+///   Our memory is counted in the cache's budget.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:54:06 EDT 2026
+//   Added GetCellsInRange.
+//
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Count our memory in the ResultCache budget, and added ForgetAll.
+//   Rely on Forget for reused addresses instead of comparing sizes.
+//
+// ****************************************************************************
+class SpanSpaceIndex
+{
+  protected:
+    int                 ncells;
+    int                 ntuples;
+    int                 nbins;
+    float               lo;
+    float               hi;
+    /// cells[binStart[b]] to cells[binStart[b+1]-1] are in bucket b,
+    /// which is (min bin) * nbins + (max bin)
+    std::vector<int>    binStart;
+    std::vector<int>    cells;
+    /// the range of each cell in the order of the cells array
+    std::vector<float>  cellMin;
+    std::vector<float>  cellMax;
+
+    typedef std::pair<eavlCellSet*,eavlArray*> Key;
+    static QMutex                           lock;
+    static std::map<Key,SpanSpaceIndex*>    indices;
+
+  public:
+    SpanSpaceIndex(eavlCellSet *cs, eavlArray *arr);
+
+    void   GetActiveCells(float value, std::vector<int> &active) const;
+    void   GetCellsInRange(float minval, float maxval, bool contained,
+                           std::vector<int> &result) const;
+    size_t GetMemoryBytes() const;
+
+    static SpanSpaceIndex *Get(eavlCellSet *cs, eavlArray *arr);
+    static void            Forget(void *part);
+    static void            ForgetAll();
+
+  protected:
+    int    GetBin(float v) const;
+};
+
+eavlDataSet *CreateCellSubset(eavlDataSet *ds, eavlCellSet *cs,
+                              const std::vector<int> &cells);
+void         FreeCellSubset(eavlDataSet *subset);
+
+#endif
@@ -0,0 +1,235 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "StageStats.h"
+
+#include <time.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+// ****************************************************************************
+// Constructor:  StageStats::StageStats
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+StageStats::StageStats()
+    : wall(0), start(0), end(0), cpu(0), peakMemoryMB(0),
+      inPoints(0), inCells(0), outPoints(0), outCells(0),
+      computed(0), cached(0), nchunks(0)
+{
+}
+
+// ****************************************************************************
+// Method:  StageStats::Add
+//
+// Purpose:
+///   Accumulate another chunk's stats into these.  Memory growth isn't
+///   additive, so we keep the largest, and chunks run at the same time,
+///   so the wall time is the span covering both.
+//
+// Arguments:
+//   s          the stats to add
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:35:52 EDT 2026
+//   Combine wall times as a span, rather than adding them.
+//
+// ****************************************************************************
+void
+StageStats::Add(const StageStats &s)
+{
+    if (s.end > 0)
+    {
+        if (end == 0 || s.start < start)
+            start = s.start;
+        end = std::max(end, s.end);
+        wall = end - start;
+    }
+    cpu          += s.cpu;
+    peakMemoryMB  = std::max(peakMemoryMB, s.peakMemoryMB);
+    inPoints     += s.inPoints;
+    inCells      += s.inCells;
+    outPoints    += s.outPoints;
+    outCells     += s.outCells;
+    computed     += s.computed;
+    cached       += s.cached;
+    nchunks      += s.nchunks;
+}
+
+void
+StageStats::SetInput(eavlDataSet *ds)
+{
+    inPoints = ds->GetNumPoints();
+    inCells = GetNumCells(ds);
+}
+
+void
+StageStats::SetOutput(eavlDataSet *ds)
+{
+    outPoints = ds->GetNumPoints();
+    outCells = GetNumCells(ds);
+}
+
+// ****************************************************************************
+// Method:  StageStats::GetNumCells
+//
+// Purpose:
+///   The number of cells in all of a data set's cell sets.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+long
+StageStats::GetNumCells(eavlDataSet *ds)
+{
+    long n = 0;
+    for (int i=0; i<ds->GetNumCellSets(); ++i)
+        n += ds->GetCellSet(i)->GetNumCells();
+    return n;
+}
+
+// ****************************************************************************
+// Method:  StageStats::Print
+//
+// Purpose:
+///   Write the stats on one line, e.g. for logging batch runs.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+StageStats::Print(ostream &out)
+{
+    out << "wall=" << wall << "s"
+        << " cpu=" << cpu << "s"
+        << " peakmem=+" << peakMemoryMB << "MB"
+        << " points=" << inPoints << "->" << outPoints
+        << " cells=" << inCells << "->" << outCells
+        << " chunks=" << computed << " computed, "
+        << cached << " cached, " << nchunks << " total";
+}
+
+// ****************************************************************************
+// Constructor:  StageTimer::StageTimer
+//
+// Purpose:
+///   Start timing.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+StageTimer::StageTimer()
+{
+    wall = GetWallTime();
+    cpu = GetThreadCPUTime();
+    peakMB = GetPeakMemoryMB();
+}
+
+// ****************************************************************************
+// Method:  StageTimer::Stop
+//
+// Purpose:
+///   Stop timing, and record the results as one computed chunk.
+//
+// Arguments:
+//   s          the stats to fill in
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:35:52 EDT 2026
+//   Record when it started and finished.
+//
+// ****************************************************************************
+void
+StageTimer::Stop(StageStats &s)
+{
+    s.start = wall;
+    s.end = GetWallTime();
+    s.wall = s.end - s.start;
+    s.cpu = GetThreadCPUTime() - cpu;
+    s.peakMemoryMB = GetPeakMemoryMB() - peakMB;
+    s.computed = 1;
+    s.nchunks = 1;
+}
+
+double
+StageTimer::GetWallTime()
+{
+#if defined(_WIN32)
+    return clock() / double(CLOCKS_PER_SEC);
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1.e6;
+#endif
+}
+
+// ****************************************************************************
+// Method:  StageTimer::GetThreadCPUTime
+//
+// Purpose:
+///   CPU time used by the calling thread, where the OS can tell us;
+///   otherwise, by the whole process.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+double
+StageTimer::GetThreadCPUTime()
+{
+#if defined(_WIN32)
+    return 0;
+#else
+    struct rusage ru;
+#if defined(RUSAGE_THREAD)
+    getrusage(RUSAGE_THREAD, &ru);
+#else
+    getrusage(RUSAGE_SELF, &ru);
+#endif
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+           (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1.e6;
+#endif
+}
+
+// ****************************************************************************
+// Method:  StageTimer::GetPeakMemoryMB
+//
+// Purpose:
+///   The process's peak resident size so far.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+double
+StageTimer::GetPeakMemoryMB()
+{
+#if defined(_WIN32)
+    return 0;
+#else
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+#if defined(__APPLE__)
+    return ru.ru_maxrss / (1024. * 1024.); // bytes
+#else
+    return ru.ru_maxrss / 1024.; // kilobytes
+#endif
+#endif
+}
@@ -0,0 +1,83 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef STAGE_STATS_H
+#define STAGE_STATS_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+
+// ****************************************************************************
+// Struct:  StageStats
+//
+// Purpose:
+///   Profiling information for one stage of a pipeline (reading the
+///   source, or one operation), either for one chunk or summed over all
+///   of them.  Times are in seconds; wall time includes any time spent
+///   waiting for the importer or EAVL executor locks, and CPU time is
+///   only the thread which did the work.  Summed over chunks, the CPU
+///   time adds up, but the wall time is the span from when the first
+///   chunk started the stage to when the last one finished it, since
+///   chunks run at the same time.  The memory is the growth in the
+///   process's peak resident size while the stage ran, which is only
+///   approximate when chunks are running at the same time.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:35:52 EDT 2026
+//   Added the start and end of the wall time, to sum it as a span.
+//
+// ****************************************************************************
+struct StageStats
+{
+    double wall;
+    double start;     ///< wall clock time the stage started, or 0
+    double end;       ///< and finished
+    double cpu;
+    double peakMemoryMB;
+    long   inPoints;
+    long   inCells;
+    long   outPoints;
+    long   outCells;
+    int    computed;  ///< chunks computed in the last execution
+    int    cached;    ///< chunks taken from the ResultCache instead
+    int    nchunks;   ///< chunks in total
+
+  public:
+    StageStats();
+    void Add(const StageStats &s);
+    void SetInput(eavlDataSet *ds);
+    void SetOutput(eavlDataSet *ds);
+    void Print(ostream &out);
+
+    static long GetNumCells(eavlDataSet *ds);
+};
+
+// ****************************************************************************
+// Class:  StageTimer
+//
+// Purpose:
+///   Measures wall time, thread CPU time, and peak memory growth from
+///   its creation until Stop.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+class StageTimer
+{
+  protected:
+    double wall;
+    double cpu;
+    double peakMB;
+  public:
+    StageTimer();
+    void Stop(StageStats &s);
+
+    static double GetWallTime();
+    static double GetThreadCPUTime();
+    static double GetPeakMemoryMB();
+};
+
+#endif
@@ -3,9 +3,9 @@
 #define OP_SURFACE_NORMALS_H
 
 #include "Operation.h"
+#include "Topology.h"
 
 #include <eavlSurfaceNormalMutator.h>
-#include <eavlCellToNodeRecenterMutator.h>
 
 // ****************************************************************************
 // Class:  SurfaceNormalsAttributes
@@ -55,19 +55,19 @@ class SurfaceNormalsAttributes : public Attribute
 //   Jeremy Meredith, Thu Nov 29 12:20:34 EST 2012
 //   Optionally recenter to a nodal variable.
 //
+//   Jeremy Meredith, Sun Oct 18 23:34:12 EDT 2026
+//   Recenter using the shared node-to-cell incidence, so repeated runs
+//   on the same mesh don't rederive it.
+//
 // ****************************************************************************
 class SurfaceNormalsOperation : public Operation
 {
     SurfaceNormalsAttributes *atts;
-    eavlSurfaceNormalMutator *mutator;
-    eavlCellToNodeRecenterMutator *recenter;
   public:
     SurfaceNormalsOperation()
         : Operation()
     {
         atts = new SurfaceNormalsAttributes;
-        mutator = new eavlSurfaceNormalMutator;
-        recenter = new eavlCellToNodeRecenterMutator;
     }
     virtual std::string GetOperationName()
     {
@@ -88,23 +88,32 @@ class SurfaceNormalsOperation : public Operation
     {
         return atts;
     }
-    virtual void Execute()
+    virtual eavlDataSet *Execute(eavlDataSet *input)
     {
-        mutator->SetDataSet(input);
         ///\todo: assuming last cell set
-        string cellset = input->GetCellSet(input->GetNumCellSets()-1)->GetName();
-        mutator->SetCellSet(cellset);
-        mutator->Execute();
+        eavlCellSet *cs = input->GetCellSet(input->GetNumCellSets()-1);
+        {
+            eavlSurfaceNormalMutator mutator;
+            mutator.SetDataSet(input);
+            mutator.SetCellSet(cs->GetName());
+            QMutexLocker lock(&eavlExecutorMutex);
+            mutator.Execute();
+        }
 
         if (atts->nodal) // nodal surface normals
         {
-            recenter->SetDataSet(input);
-            recenter->SetField("surface_normals");
-            recenter->SetCellSet(cellset);
-            recenter->Execute();
+            eavlField *normals = NULL;
+            for (int i=0; i<input->GetNumFields(); ++i)
+            {
+                if (input->GetField(i)->GetArray()->GetName() == "surface_normals")
+                    normals = input->GetField(i);
+            }
+            if (!normals)
+                throw eavlException("Surface normals weren't created.");
+            input->AddField(CreateNodeCenteredField(input, cs, normals));
         }
 
-        output = input;
+        return input;
     }
 };
 
@@ -3,6 +3,9 @@
 #define OP_THRESHOLD_H
 
 #include "Operation.h"
+#include "CopyOnWrite.h"
+#include "SortedIndex.h"
+#include "SpanSpace.h"
 
 #include <eavlThresholdMutator.h>
 
@@ -17,6 +20,10 @@
 // Creation:    August 12, 2014
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:54:06 EDT 2026
+//   Added the option to index the field, and initialize
+//   all_points_required.
+//
 // ****************************************************************************
 class ThresholdAttributes : public Attribute
 {
@@ -25,6 +32,7 @@ class ThresholdAttributes : public Attribute
     float minvalue;
     float maxvalue;
     bool all_points_required;
+    bool use_index;
   public:
     virtual const char *GetType() {return "ThresholdAttributes";}
     ThresholdAttributes() : Attribute()
@@ -33,6 +41,8 @@ class ThresholdAttributes : public Attribute
         cellset = "(default)";
         minvalue = -FLT_MAX;
         maxvalue = +FLT_MAX;
+        all_points_required = false;
+        use_index = false;
     }
     virtual ~ThresholdAttributes()
     {
@@ -44,6 +54,7 @@ class ThresholdAttributes : public Attribute
         Add("Minimum value", minvalue);
         Add("Maximum value", maxvalue);
         Add("Require all cell points in range for nodal fields", all_points_required);
+        Add("Index the field for fast range changes", use_index);
     }
     
 };
@@ -58,17 +69,19 @@ class ThresholdAttributes : public Attribute
 // Creation:    August 12, 2014
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 22:54:06 EDT 2026
+//   With use_index, find the cells in range with an index on the field
+//   (built the first time) and only give the mutator those cells.
+//
 // ****************************************************************************
 class ThresholdOperation : public Operation
 {
     ThresholdAttributes *atts;
-    eavlThresholdMutator *mutator;
   public:
     ThresholdOperation()
         : Operation()
     {
         atts = new ThresholdAttributes;
-        mutator = new eavlThresholdMutator;
     }
     virtual std::string GetOperationName()
     {
@@ -100,18 +113,141 @@ class ThresholdOperation : public Operation
         std::vector<std::string> vars;
         return vars;
     }
-    virtual void Execute()
+    virtual eavlDataSet *Execute(eavlDataSet *input)
+    {
+        string cellset = atts->cellset;
+        if (cellset == "(default)")
+            cellset = input->GetCellSet(0)->GetName();
+
+        std::vector<int> cells;
+        if (atts->use_index && GetIndexedCells(input, cellset, cells) &&
+            !cells.empty())
+        {
+            return ExecuteOnCells(input, cellset, cells);
+        }
+
+        eavlThresholdMutator mutator;
+        mutator.SetDataSet(input);
+        mutator.SetCellSet(cellset);
+        mutator.SetField(atts->field);
+        mutator.SetRange(atts->minvalue, atts->maxvalue);
+        mutator.SetNodalThresholdAllPointsRequired(atts->all_points_required);
+        QMutexLocker lock(&eavlExecutorMutex);
+        mutator.Execute();
+        return input;
+    }
+
+  protected:
+    // ************************************************************************
+    // Method:  ThresholdOperation::GetIndexedCells
+    //
+    // Purpose:
+    ///   Use an index on the field to find the cells which may be in
+    ///   range: a sorted index for a cell field, and a span space index
+    ///   for a nodal one.  These may include a few extra cells (e.g. a
+    ///   cell whose points are on both sides of the range but none in
+    ///   it), which the mutator will drop.  Returns false if the field
+    ///   can't be indexed.
+    //
+    // Programmer:  Jeremy Meredith
+    // Creation:    October 18, 2026
+    //
+    // Modifications:
+    // ************************************************************************
+    bool GetIndexedCells(eavlDataSet *input, const string &cellset,
+                         std::vector<int> &cells)
+    {
+        eavlCellSet *cs = NULL;
+        for (int i=0; i<input->GetNumCellSets(); ++i)
+        {
+            if (input->GetCellSet(i)->GetName() == cellset)
+                cs = input->GetCellSet(i);
+        }
+        eavlField *field = NULL;
+        for (int i=0; i<input->GetNumFields(); ++i)
+        {
+            if (input->GetField(i)->GetArray()->GetName() == atts->field)
+                field = input->GetField(i);
+        }
+        if (!cs || !field ||
+            field->GetArray()->GetNumberOfComponents() != 1)
+        {
+            return false;
+        }
+
+        if (field->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+            field->GetAssocCellSet() == cellset)
+        {
+            SortedValueIndex *index = SortedValueIndex::Get(field->GetArray());
+            index->GetTuplesInRange(atts->minvalue, atts->maxvalue, cells);
+            return true;
+        }
+        else if (field->GetAssociation() == eavlField::ASSOC_POINTS)
+        {
+            SpanSpaceIndex *index = SpanSpaceIndex::Get(cs, field->GetArray());
+            index->GetCellsInRange(atts->minvalue, atts->maxvalue,
+                                   atts->all_points_required, cells);
+            return true;
+        }
+        return false;
+    }
+
+    // ************************************************************************
+    // Method:  ThresholdOperation::ExecuteOnCells
+    //
+    // Purpose:
+    ///   Run the mutator on a data set with only the given cells, then
+    ///   move what it added over to the input.  Its new cell set is
+    ///   copied, since it may refer back to our temporary subset.
+    //
+    // Programmer:  Jeremy Meredith
+    // Creation:    October 18, 2026
+    //
+    // Modifications:
+    // ************************************************************************
+    eavlDataSet *ExecuteOnCells(eavlDataSet *input, const string &cellset,
+                                const std::vector<int> &cells)
     {
-        mutator->SetDataSet(input);
-	if (atts->cellset == "(default)")
-	    mutator->SetCellSet(input->GetCellSet(0)->GetName());
-	else
-	    mutator->SetCellSet(atts->cellset);
-        mutator->SetField(atts->field);
-        mutator->SetRange(atts->minvalue, atts->maxvalue);
-        mutator->SetNodalThresholdAllPointsRequired(atts->all_points_required);
-        mutator->Execute();
-        output = input;
+        eavlCellSet *cs = NULL;
+        for (int i=0; i<input->GetNumCellSets(); ++i)
+        {
+            if (input->GetCellSet(i)->GetName() == cellset)
+                cs = input->GetCellSet(i);
+        }
+        eavlDataSet *subset = CreateCellSubset(input, cs, cells);
+        int ncellsets = subset->GetNumCellSets();
+        int nfields = subset->GetNumFields();
+
+        {
+            eavlThresholdMutator mutator;
+            mutator.SetDataSet(subset);
+            mutator.SetCellSet(cellset);
+            mutator.SetField(atts->field);
+            mutator.SetRange(atts->minvalue, atts->maxvalue);
+            mutator.SetNodalThresholdAllPointsRequired(atts->all_points_required);
+            try
+            {
+                QMutexLocker lock(&eavlExecutorMutex);
+                mutator.Execute();
+            }
+            catch (...)
+            {
+                FreeCellSubset(subset);
+                throw;
+            }
+        }
+
+        for (int i=ncellsets; i<subset->GetNumCellSets(); ++i)
+        {
+            eavlCellSet *added = subset->GetCellSet(i);
+            input->AddCellSet(CopyCellSet(added));
+            delete added;
+        }
+        for (int i=nfields; i<subset->GetNumFields(); ++i)
+            input->AddField(subset->GetField(i));
+
+        FreeCellSubset(subset);
+        return input;
     }
 };
 
@@ -0,0 +1,1033 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "Topology.h"
+#include "ResultCache.h"
+
+#include <QAtomicInt>
+#include <QMutexLocker>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+
+QMutex                                      TopologyCache::lock;
+std::map<eavlCellSet*,CellSetTopology*>     TopologyCache::topologies;
+
+/// Cells (or faces, or points) per piece of work.
+static const int topoBlockSize = 1 << 15;
+
+// Faces of each 3D cell shape, and edges of each 2D one, as local point
+// indices in VTK ordering, wound so the faces point out of the cell.
+static const int tetFaces[4][4]    = {{0,1,3,-1}, {1,2,3,-1}, {2,0,3,-1},
+                                      {0,2,1,-1}};
+static const int pyrFaces[5][4]    = {{0,3,2,1}, {0,1,4,-1}, {1,2,4,-1},
+                                      {2,3,4,-1}, {3,0,4,-1}};
+static const int wedgeFaces[5][4]  = {{0,1,2,-1}, {3,5,4,-1}, {0,3,4,1},
+                                      {1,4,5,2}, {2,5,3,0}};
+static const int hexFaces[6][4]    = {{0,4,7,3}, {1,2,6,5}, {0,1,5,4},
+                                      {3,7,6,2}, {0,3,2,1}, {4,5,6,7}};
+static const int voxelFaces[6][4]  = {{0,4,6,2}, {1,3,7,5}, {0,1,5,4},
+                                      {2,6,7,3}, {0,2,3,1}, {4,5,7,6}};
+static const int triEdges[3][4]    = {{0,1,-1,-1}, {1,2,-1,-1}, {2,0,-1,-1}};
+static const int quadEdges[4][4]   = {{0,1,-1,-1}, {1,2,-1,-1}, {2,3,-1,-1},
+                                      {3,0,-1,-1}};
+static const int pixelEdges[4][4]  = {{0,1,-1,-1}, {1,3,-1,-1}, {3,2,-1,-1},
+                                      {2,0,-1,-1}};
+
+// Edges of each 3D cell shape.
+static const int tetEdges[6][4]    = {{0,1,-1,-1}, {1,2,-1,-1}, {2,0,-1,-1},
+                                      {0,3,-1,-1}, {1,3,-1,-1}, {2,3,-1,-1}};
+static const int pyrEdges[8][4]    = {{0,1,-1,-1}, {1,2,-1,-1}, {2,3,-1,-1},
+                                      {3,0,-1,-1}, {0,4,-1,-1}, {1,4,-1,-1},
+                                      {2,4,-1,-1}, {3,4,-1,-1}};
+static const int wedgeEdges[9][4]  = {{0,1,-1,-1}, {1,2,-1,-1}, {2,0,-1,-1},
+                                      {3,4,-1,-1}, {4,5,-1,-1}, {5,3,-1,-1},
+                                      {0,3,-1,-1}, {1,4,-1,-1}, {2,5,-1,-1}};
+static const int hexEdges[12][4]   = {{0,1,-1,-1}, {1,2,-1,-1}, {2,3,-1,-1},
+                                      {3,0,-1,-1}, {4,5,-1,-1}, {5,6,-1,-1},
+                                      {6,7,-1,-1}, {7,4,-1,-1}, {0,4,-1,-1},
+                                      {1,5,-1,-1}, {2,6,-1,-1}, {3,7,-1,-1}};
+static const int voxelEdges[12][4] = {{0,1,-1,-1}, {1,3,-1,-1}, {3,2,-1,-1},
+                                      {2,0,-1,-1}, {4,5,-1,-1}, {5,7,-1,-1},
+                                      {7,6,-1,-1}, {6,4,-1,-1}, {0,4,-1,-1},
+                                      {1,5,-1,-1}, {2,6,-1,-1}, {3,7,-1,-1}};
+static const int beamEdges[1][4]   = {{0,1,-1,-1}};
+
+// ****************************************************************************
+// Struct:  CellEntities
+//
+// Purpose:
+///   The faces or edges of one cell, as point indices.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct CellEntities
+{
+    int n;
+    int nnodes[12];
+    int nodes[12][4];
+
+    template <int N>
+    void Set(const eavlCell &cell, const int (&table)[N][4])
+    {
+        n = N;
+        for (int f=0; f<N; ++f)
+        {
+            nnodes[f] = 0;
+            for (int j=0; j<4 && table[f][j] >= 0; ++j)
+                nodes[f][nnodes[f]++] = cell.indices[table[f][j]];
+        }
+    }
+
+    bool SetPolygon(const eavlCell &cell)
+    {
+        if (cell.numIndices > 12)
+            return false;
+        n = cell.numIndices;
+        for (int f=0; f<n; ++f)
+        {
+            nnodes[f] = 2;
+            nodes[f][0] = cell.indices[f];
+            nodes[f][1] = cell.indices[(f+1) % n];
+        }
+        return true;
+    }
+
+    /// Get the faces (or edges, for 2D cells); false if we don't know
+    /// the cell's shape.
+    bool GetFaces(const eavlCell &cell)
+    {
+        switch (cell.type)
+        {
+          case EAVL_TET:     Set(cell, tetFaces);   return true;
+          case EAVL_PYRAMID: Set(cell, pyrFaces);   return true;
+          case EAVL_WEDGE:   Set(cell, wedgeFaces); return true;
+          case EAVL_HEX:     Set(cell, hexFaces);   return true;
+          case EAVL_VOXEL:   Set(cell, voxelFaces); return true;
+          case EAVL_TRI:     Set(cell, triEdges);   return true;
+          case EAVL_QUAD:    Set(cell, quadEdges);  return true;
+          case EAVL_PIXEL:   Set(cell, pixelEdges); return true;
+          case EAVL_POLYGON: return SetPolygon(cell);
+          default:           return false;
+        }
+    }
+
+    /// Get the edges; false if we don't know the cell's shape.
+    bool GetEdges(const eavlCell &cell)
+    {
+        switch (cell.type)
+        {
+          case EAVL_TET:     Set(cell, tetEdges);   return true;
+          case EAVL_PYRAMID: Set(cell, pyrEdges);   return true;
+          case EAVL_WEDGE:   Set(cell, wedgeEdges); return true;
+          case EAVL_HEX:     Set(cell, hexEdges);   return true;
+          case EAVL_VOXEL:   Set(cell, voxelEdges); return true;
+          case EAVL_TRI:     Set(cell, triEdges);   return true;
+          case EAVL_QUAD:    Set(cell, quadEdges);  return true;
+          case EAVL_PIXEL:   Set(cell, pixelEdges); return true;
+          case EAVL_BEAM:    Set(cell, beamEdges);  return true;
+          case EAVL_POLYGON: return SetPolygon(cell);
+          default:           return false;
+        }
+    }
+
+    bool Get(const eavlCell &cell, bool edges)
+    {
+        return edges ? GetEdges(cell) : GetFaces(cell);
+    }
+};
+
+// ****************************************************************************
+// Struct:  EntityRecord
+//
+// Purpose:
+///   A face or edge for matching: its points sorted (so it compares
+///   equal to its twins), and which one of which cell it is.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct EntityRecord
+{
+    int key[4];
+    int cell;
+    int local;
+
+    bool SameEntity(const EntityRecord &r) const
+    {
+        return key[0] == r.key[0] && key[1] == r.key[1] &&
+               key[2] == r.key[2] && key[3] == r.key[3];
+    }
+    bool operator<(const EntityRecord &r) const
+    {
+        for (int i=0; i<4; ++i)
+        {
+            if (key[i] != r.key[i])
+                return key[i] < r.key[i];
+        }
+        return cell < r.cell;
+    }
+};
+
+/// A matched face or edge: its first use as (cell << 4 | local), and
+/// the other cell using it, if any.
+struct EntityMatch
+{
+    long long first;
+    int       second;
+
+    bool operator<(const EntityMatch &m) const { return first < m.first; }
+};
+
+// ****************************************************************************
+// Struct:  EntityCollector
+//
+// Purpose:
+///   Function object for QtConcurrent putting the faces or edges of one
+///   block of cells into partitions by hash.  Each block has its own
+///   list per partition, so the threads don't share anything they write.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct EntityCollector
+{
+    typedef void result_type;
+
+    eavlCellSet                               *cs;
+    bool                                       edges;
+    int                                        ncells;
+    int                                        npartitions;
+    std::vector< std::vector<EntityRecord> >  *buckets;
+    QAtomicInt                                *unsupported;
+
+    void operator()(int &block)
+    {
+        int begin = block * topoBlockSize;
+        int end = std::min(begin + topoBlockSize, ncells);
+        std::vector<EntityRecord> *mine = &(*buckets)[block * npartitions];
+        CellEntities ents;
+        for (int i=begin; i<end; ++i)
+        {
+            if (!ents.Get(cs->GetCellNodes(i), edges))
+            {
+                unsupported->fetchAndStoreOrdered(1);
+                return;
+            }
+            for (int f=0; f<ents.n; ++f)
+            {
+                EntityRecord r;
+                r.cell = i;
+                r.local = f;
+                for (int j=0; j<4; ++j)
+                    r.key[j] = (j < ents.nnodes[f]) ? ents.nodes[f][j] : -1;
+                std::sort(r.key, r.key + 4);
+
+                unsigned int h = 0;
+                for (int j=0; j<4; ++j)
+                    h = h * 2654435761u + (unsigned int)r.key[j];
+                mine[(h >> 7) % npartitions].push_back(r);
+            }
+        }
+    }
+};
+
+// ****************************************************************************
+// Struct:  EntityMatcher
+//
+// Purpose:
+///   Function object for QtConcurrent pairing up the twins in one
+///   partition.  An entity used by more than two cells (which only
+///   happens for edges, or a bad mesh) keeps its first two.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct EntityMatcher
+{
+    typedef void result_type;
+
+    int                                        nblocks;
+    int                                        npartitions;
+    std::vector< std::vector<EntityRecord> >  *buckets;
+    std::vector< std::vector<EntityMatch> >   *matches;
+
+    void operator()(int &partition)
+    {
+        std::vector<EntityRecord> recs;
+        for (int b=0; b<nblocks; ++b)
+        {
+            std::vector<EntityRecord> &bucket =
+                (*buckets)[b * npartitions + partition];
+            recs.insert(recs.end(), bucket.begin(), bucket.end());
+            std::vector<EntityRecord>().swap(bucket);
+        }
+        std::sort(recs.begin(), recs.end());
+
+        std::vector<EntityMatch> &out = (*matches)[partition];
+        size_t i = 0;
+        while (i < recs.size())
+        {
+            size_t j = i + 1;
+            while (j < recs.size() && recs[j].SameEntity(recs[i]))
+                ++j;
+            EntityMatch m;
+            m.first = (long long)recs[i].cell << 4 | recs[i].local;
+            m.second = (j > i + 1) ? recs[i+1].cell : -1;
+            out.push_back(m);
+            i = j;
+        }
+    }
+};
+
+// ****************************************************************************
+// Struct:  EntityFiller
+//
+// Purpose:
+///   Function object for QtConcurrent filling in the points and cells
+///   of one block of the matched faces or edges.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct EntityFiller
+{
+    typedef void result_type;
+
+    eavlCellSet                     *cs;
+    bool                             edges;
+    int                              width;
+    const std::vector<EntityMatch>  *all;
+    int                             *nodes;
+    int                             *cells;
+
+    void operator()(int &block)
+    {
+        int begin = block * topoBlockSize;
+        int end = std::min(begin + topoBlockSize, int(all->size()));
+        CellEntities ents;
+        int lastcell = -1;
+        for (int i=begin; i<end; ++i)
+        {
+            int cell = int((*all)[i].first >> 4);
+            int local = int((*all)[i].first & 15);
+            if (cell != lastcell)
+            {
+                ents.Get(cs->GetCellNodes(cell), edges);
+                lastcell = cell;
+            }
+            for (int j=0; j<width; ++j)
+                nodes[long(i)*width + j] = (j < ents.nnodes[local]) ?
+                                           ents.nodes[local][j] : -1;
+            cells[2*i]   = cell;
+            cells[2*i+1] = (*all)[i].second;
+        }
+    }
+};
+
+// ****************************************************************************
+// Function:  BuildEntities
+//
+// Purpose:
+///   Find the unique faces or edges of a cell set.  Returns false if
+///   it has cells of a shape we don't handle.
+//
+// Arguments:
+//   cs         the cell set
+//   edges      true for edges, false for faces
+//   width      points to store per entity
+//   nodes      (output) the points, width per entity
+//   cells      (output) the two cells using each entity
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static bool
+BuildEntities(eavlCellSet *cs, bool edges, int width,
+              std::vector<int> &nodes, std::vector<int> &cells)
+{
+    int ncells = cs->GetNumCells();
+    int nblocks = (ncells + topoBlockSize - 1) / topoBlockSize;
+    int npartitions = 4 * std::max(1, QThread::idealThreadCount());
+
+    std::vector< std::vector<EntityRecord> > buckets(nblocks * npartitions);
+    QAtomicInt unsupported(0);
+
+    EntityCollector collector;
+    collector.cs = cs;
+    collector.edges = edges;
+    collector.ncells = ncells;
+    collector.npartitions = npartitions;
+    collector.buckets = &buckets;
+    collector.unsupported = &unsupported;
+    std::vector<int> blocks;
+    for (int b=0; b<nblocks; ++b)
+        blocks.push_back(b);
+    QtConcurrent::blockingMap(blocks, collector);
+    if (unsupported != 0)
+        return false;
+
+    std::vector< std::vector<EntityMatch> > matches(npartitions);
+    EntityMatcher matcher;
+    matcher.nblocks = nblocks;
+    matcher.npartitions = npartitions;
+    matcher.buckets = &buckets;
+    matcher.matches = &matches;
+    std::vector<int> partitions;
+    for (int p=0; p<npartitions; ++p)
+        partitions.push_back(p);
+    QtConcurrent::blockingMap(partitions, matcher);
+
+    std::vector<EntityMatch> all;
+    for (int p=0; p<npartitions; ++p)
+    {
+        all.insert(all.end(), matches[p].begin(), matches[p].end());
+        std::vector<EntityMatch>().swap(matches[p]);
+    }
+    std::sort(all.begin(), all.end());
+
+    int n = all.size();
+    nodes.resize(long(n) * width);
+    cells.resize(2 * n);
+    if (n == 0)
+        return true;
+
+    EntityFiller filler;
+    filler.cs = cs;
+    filler.edges = edges;
+    filler.width = width;
+    filler.all = &all;
+    filler.nodes = &nodes[0];
+    filler.cells = &cells[0];
+    blocks.clear();
+    for (int b=0; b*topoBlockSize < n; ++b)
+        blocks.push_back(b);
+    QtConcurrent::blockingMap(blocks, filler);
+    return true;
+}
+
+// ****************************************************************************
+// Struct:  IncidenceCollector
+//
+// Purpose:
+///   Function object for QtConcurrent putting the (point, cell) pairs of
+///   one block of cells into partitions by ranges of point indices.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct IncidenceCollector
+{
+    typedef void result_type;
+
+    eavlCellSet                                *cs;
+    int                                         ncells;
+    int                                         npoints;
+    int                                         npartitions;
+    std::vector< std::vector<std::pair<int,int> > > *buckets;
+
+    void operator()(int &block)
+    {
+        int begin = block * topoBlockSize;
+        int end = std::min(begin + topoBlockSize, ncells);
+        std::vector<std::pair<int,int> > *mine =
+            &(*buckets)[block * npartitions];
+        for (int i=begin; i<end; ++i)
+        {
+            eavlCell cell = cs->GetCellNodes(i);
+            for (int j=0; j<cell.numIndices; ++j)
+            {
+                int p = cell.indices[j];
+                if (p < 0 || p >= npoints)
+                    continue;
+                int part = int((long long)p * npartitions / npoints);
+                mine[part].push_back(std::pair<int,int>(p, i));
+            }
+        }
+    }
+};
+
+// ****************************************************************************
+// Struct:  IncidenceBuilder
+//
+// Purpose:
+///   Function object for QtConcurrent counting-sorting one partition's
+///   pairs by point.  The blocks are in cell order, so each point's
+///   cells come out in increasing order.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct IncidenceBuilder
+{
+    typedef void result_type;
+
+    int                                         nblocks;
+    int                                         npoints;
+    int                                         npartitions;
+    std::vector< std::vector<std::pair<int,int> > > *buckets;
+    std::vector<int>                           *counts;
+    std::vector< std::vector<int> >            *partCells;
+
+    void operator()(int &partition)
+    {
+        // the points p with p * npartitions / npoints == partition
+        int lo = int(((long long)partition * npoints + npartitions - 1) /
+                     npartitions);
+        int hi = int(((long long)(partition+1) * npoints + npartitions - 1) /
+                     npartitions);
+
+        size_t total = 0;
+        for (int b=0; b<nblocks; ++b)
+        {
+            std::vector<std::pair<int,int> > &bucket =
+                (*buckets)[b * npartitions + partition];
+            total += bucket.size();
+            for (size_t k=0; k<bucket.size(); ++k)
+                (*counts)[bucket[k].first]++;
+        }
+
+        // offsets within this partition, for the points it owns
+        std::vector<int> &out = (*partCells)[partition];
+        out.resize(total);
+        std::vector<int> next(hi - lo + 1, 0);
+        for (int p=lo; p<hi; ++p)
+            next[p-lo+1] = next[p-lo] + (*counts)[p];
+
+        for (int b=0; b<nblocks; ++b)
+        {
+            std::vector<std::pair<int,int> > &bucket =
+                (*buckets)[b * npartitions + partition];
+            for (size_t k=0; k<bucket.size(); ++k)
+                out[next[bucket[k].first - lo]++] = bucket[k].second;
+            std::vector<std::pair<int,int> >().swap(bucket);
+        }
+    }
+};
+
+// ****************************************************************************
+// Function:  BuildIncidence
+//
+// Purpose:
+///   Find the cells using each point.
+//
+// Arguments:
+//   cs         the cell set
+//   npoints    the number of points in its data set
+//   start      (output) per point offsets into cells, plus the total
+//   cells      (output) the cells using each point
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+BuildIncidence(eavlCellSet *cs, int npoints,
+               std::vector<int> &start, std::vector<int> &cells)
+{
+    int ncells = cs->GetNumCells();
+    int nblocks = (ncells + topoBlockSize - 1) / topoBlockSize;
+    int npartitions = std::max(1, std::min(npoints,
+                                   4 * std::max(1, QThread::idealThreadCount())));
+
+    start.assign(npoints + 1, 0);
+    cells.clear();
+    if (npoints == 0)
+        return;
+
+    std::vector< std::vector<std::pair<int,int> > > buckets(nblocks * npartitions);
+    IncidenceCollector collector;
+    collector.cs = cs;
+    collector.ncells = ncells;
+    collector.npoints = npoints;
+    collector.npartitions = npartitions;
+    collector.buckets = &buckets;
+    std::vector<int> blocks;
+    for (int b=0; b<nblocks; ++b)
+        blocks.push_back(b);
+    QtConcurrent::blockingMap(blocks, collector);
+
+    // each partition only touches the counts for its own points
+    std::vector<int> counts(npoints, 0);
+    std::vector< std::vector<int> > partCells(npartitions);
+    IncidenceBuilder builder;
+    builder.nblocks = nblocks;
+    builder.npoints = npoints;
+    builder.npartitions = npartitions;
+    builder.buckets = &buckets;
+    builder.counts = &counts;
+    builder.partCells = &partCells;
+    std::vector<int> partitions;
+    for (int p=0; p<npartitions; ++p)
+        partitions.push_back(p);
+    QtConcurrent::blockingMap(partitions, builder);
+
+    for (int p=0; p<npoints; ++p)
+        start[p+1] = start[p] + counts[p];
+    cells.reserve(start[npoints]);
+    for (int p=0; p<npartitions; ++p)
+    {
+        cells.insert(cells.end(), partCells[p].begin(), partCells[p].end());
+        std::vector<int>().swap(partCells[p]);
+    }
+}
+
+// ****************************************************************************
+// Constructor:  CellSetTopology::CellSetTopology
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+CellSetTopology::CellSetTopology(int n)
+    : ncells(n), refs(0), forgotten(false),
+      haveNodeCells(false), haveFaces(false), haveEdges(false)
+{
+}
+
+// ****************************************************************************
+// Method:  CellSetTopology::GetMemoryBytes
+//
+// Purpose:
+///   The memory used by the tables built so far.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+size_t
+CellSetTopology::GetMemoryBytes() const
+{
+    return (nodeCellStart.size() + nodeCells.size() +
+            faceNodes.size() + faceCells.size() +
+            edgeNodes.size()) * sizeof(int);
+}
+
+// ****************************************************************************
+// Method:  TopologyCache::GetEntry
+//
+// Purpose:
+///   Get the (possibly empty) topology for a cell set, with a
+///   reference for the caller.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   Count a reference.  Don't free an entry whose size doesn't match;
+//   someone may be reading it, and we're told to forget a cell set
+//   before its address can be reused.
+//
+// ****************************************************************************
+CellSetTopology *
+TopologyCache::GetEntry(eavlCellSet *cs)
+{
+    QMutexLocker locker(&lock);
+    CellSetTopology *&topo = topologies[cs];
+    if (!topo)
+        topo = new CellSetTopology(cs->GetNumCells());
+    topo->refs++;
+    return topo;
+}
+
+// ****************************************************************************
+// Method:  TopologyCache::Release
+//
+// Purpose:
+///   Give back the reference from a Get, freeing the topology if the
+///   cache has already dropped it.
+//
+// Arguments:
+//   topo       the topology (may be NULL)
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+TopologyCache::Release(const CellSetTopology *topo)
+{
+    if (!topo)
+        return;
+    QMutexLocker locker(&lock);
+    CellSetTopology *t = const_cast<CellSetTopology*>(topo);
+    if (--t->refs == 0 && t->forgotten)
+    {
+        ResultCache::RemoveDerivedBytes(t->GetMemoryBytes());
+        delete t;
+    }
+}
+
+// ****************************************************************************
+// Method:  TopologyCache::Drop
+//
+// Purpose:
+///   Free a topology the cache is done with, or leave it for the last
+///   Release if someone is still reading it.  The lock must be held.
+//
+// Arguments:
+//   topo       the topology, already removed from the map
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+TopologyCache::Drop(CellSetTopology *topo)
+{
+    if (topo->refs > 0)
+    {
+        topo->forgotten = true;
+        return;
+    }
+    ResultCache::RemoveDerivedBytes(topo->GetMemoryBytes());
+    delete topo;
+}
+
+// ****************************************************************************
+// Method:  TopologyCache::GetNodeCells
+//
+// Purpose:
+///   Get the topology for a cell set with its node-to-cell incidence.
+///   Give it back with Release.
+//
+// Arguments:
+//   cs         the cell set
+//   npoints    the number of points in its data set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   The caller gets a reference.
+//
+// ****************************************************************************
+const CellSetTopology *
+TopologyCache::GetNodeCells(eavlCellSet *cs, int npoints)
+{
+    CellSetTopology *topo = GetEntry(cs);
+    {
+        QMutexLocker locker(&lock);
+        if (topo->haveNodeCells)
+            return topo;
+    }
+
+    std::vector<int> start, cells;
+    try
+    {
+        BuildIncidence(cs, npoints, start, cells);
+    }
+    catch (...)
+    {
+        Release(topo);
+        throw;
+    }
+
+    QMutexLocker locker(&lock);
+    if (!topo->haveNodeCells)
+    {
+        topo->nodeCellStart.swap(start);
+        topo->nodeCells.swap(cells);
+        topo->haveNodeCells = true;
+        ResultCache::AddDerivedBytes((topo->nodeCellStart.size() +
+                                      topo->nodeCells.size()) * sizeof(int));
+    }
+    return topo;
+}
+
+// ****************************************************************************
+// Method:  TopologyCache::GetFaces
+//
+// Purpose:
+///   Get the topology for a cell set with its face table, or NULL if
+///   it has cells of a shape we don't handle.  Give it back with
+///   Release.
+//
+// Arguments:
+//   cs         the cell set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   The caller gets a reference.
+//
+// ****************************************************************************
+const CellSetTopology *
+TopologyCache::GetFaces(eavlCellSet *cs)
+{
+    CellSetTopology *topo = GetEntry(cs);
+    {
+        QMutexLocker locker(&lock);
+        if (topo->haveFaces)
+            return topo;
+    }
+
+    std::vector<int> nodes, cells;
+    bool built = false;
+    try
+    {
+        built = BuildEntities(cs, false, 4, nodes, cells);
+    }
+    catch (...)
+    {
+        Release(topo);
+        throw;
+    }
+    if (!built)
+    {
+        Release(topo);
+        return NULL;
+    }
+
+    QMutexLocker locker(&lock);
+    if (!topo->haveFaces)
+    {
+        topo->faceNodes.swap(nodes);
+        topo->faceCells.swap(cells);
+        topo->haveFaces = true;
+        ResultCache::AddDerivedBytes((topo->faceNodes.size() +
+                                      topo->faceCells.size()) * sizeof(int));
+    }
+    return topo;
+}
+
+// ****************************************************************************
+// Method:  TopologyCache::GetEdges
+//
+// Purpose:
+///   Get the topology for a cell set with its edge table, or NULL if
+///   it has cells of a shape we don't handle.  Give it back with
+///   Release.
+//
+// Arguments:
+//   cs         the cell set
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   The caller gets a reference.
+//
+// ****************************************************************************
+const CellSetTopology *
+TopologyCache::GetEdges(eavlCellSet *cs)
+{
+    CellSetTopology *topo = GetEntry(cs);
+    {
+        QMutexLocker locker(&lock);
+        if (topo->haveEdges)
+            return topo;
+    }
+
+    std::vector<int> nodes, cells;
+    bool built = false;
+    try
+    {
+        built = BuildEntities(cs, true, 2, nodes, cells);
+    }
+    catch (...)
+    {
+        Release(topo);
+        throw;
+    }
+    if (!built)
+    {
+        Release(topo);
+        return NULL;
+    }
+
+    QMutexLocker locker(&lock);
+    if (!topo->haveEdges)
+    {
+        topo->edgeNodes.swap(nodes);
+        topo->haveEdges = true;
+        ResultCache::AddDerivedBytes(topo->edgeNodes.size() * sizeof(int));
+    }
+    return topo;
+}
+
+// ****************************************************************************
+// Method:  TopologyCache::Forget
+//
+// Purpose:
+///   Drop the topology of a cell set which is about to be freed.  No
+///   pipeline is executing then, but a proxy may still be being built
+///   from it; if so, it's freed at the build's Release.
+//
+// Arguments:
+//   part       the cell set (or an array, which we ignore)
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   Don't free a topology someone is still reading.
+//
+// ****************************************************************************
+void
+TopologyCache::Forget(void *part)
+{
+    QMutexLocker locker(&lock);
+    std::map<eavlCellSet*,CellSetTopology*>::iterator it =
+        topologies.find(static_cast<eavlCellSet*>(part));
+    if (it == topologies.end())
+        return;
+    Drop(it->second);
+    topologies.erase(it);
+}
+
+// ****************************************************************************
+// Method:  TopologyCache::ForgetAll
+//
+// Purpose:
+///   Drop every topology, for the ResultCache to get back under its
+///   budget.  They're rebuilt on demand.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+TopologyCache::ForgetAll()
+{
+    QMutexLocker locker(&lock);
+    std::map<eavlCellSet*,CellSetTopology*>::iterator it;
+    for (it = topologies.begin(); it != topologies.end(); ++it)
+        Drop(it->second);
+    topologies.clear();
+}
+
+// ****************************************************************************
+// Struct:  NodeAverager
+//
+// Purpose:
+///   Function object for QtConcurrent averaging a cell field onto one
+///   block of points, using the shared node-to-cell incidence.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct NodeAverager
+{
+    typedef void result_type;
+
+    const CellSetTopology *topo;
+    eavlArray             *in;
+    const float           *invals;
+    eavlFloatArray        *out;
+    int                    ncomp;
+    int                    npoints;
+
+    void operator()(int &block)
+    {
+        int begin = block * topoBlockSize;
+        int end = std::min(begin + topoBlockSize, npoints);
+        int nknown = int(topo->nodeCellStart.size()) - 1;
+        for (int p=begin; p<end; ++p)
+        {
+            int s = (p < nknown) ? topo->nodeCellStart[p] : 0;
+            int e = (p < nknown) ? topo->nodeCellStart[p+1] : 0;
+            for (int c=0; c<ncomp; ++c)
+            {
+                double sum = 0;
+                for (int k=s; k<e; ++k)
+                {
+                    int cell = topo->nodeCells[k];
+                    sum += invals ? invals[long(cell)*ncomp + c]
+                                  : in->GetComponentAsDouble(cell, c);
+                }
+                out->SetComponentFromDouble(p, c, (e > s) ? sum / (e - s) : 0.);
+            }
+        }
+    }
+};
+
+// ****************************************************************************
+// Function:  CreateNodeCenteredField
+//
+// Purpose:
+///   Average a cell field onto the points, like EAVL's cell-to-node
+///   recentering, but with the incidence from the TopologyCache.  The
+///   new field is named "nodecentered_" plus the cell field's name.
+//
+// Arguments:
+//   ds         the data set
+//   cs         the cell set the field is on
+//   cellfield  the cell field
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   Release the topology when we're done with it.
+//
+// ****************************************************************************
+eavlField *
+CreateNodeCenteredField(eavlDataSet *ds, eavlCellSet *cs, eavlField *cellfield)
+{
+    int npoints = ds->GetNumPoints();
+    const CellSetTopology *topo = TopologyCache::GetNodeCells(cs, npoints);
+
+    eavlArray *in = cellfield->GetArray();
+    int ncomp = in->GetNumberOfComponents();
+    eavlFloatArray *out = new eavlFloatArray(std::string("nodecentered_") +
+                                             in->GetName(), ncomp, npoints);
+
+    NodeAverager averager;
+    averager.topo = topo;
+    averager.in = in;
+    averager.invals = NULL;
+    // make sure the values are on the host before the threads start
+    if (dynamic_cast<eavlFloatArray*>(in))
+        averager.invals = (const float*)in->GetHostArray();
+    averager.out = out;
+    averager.ncomp = ncomp;
+    averager.npoints = npoints;
+    std::vector<int> blocks;
+    for (int b=0; b*topoBlockSize < npoints; ++b)
+        blocks.push_back(b);
+    try
+    {
+        QtConcurrent::blockingMap(blocks, averager);
+    }
+    catch (...)
+    {
+        TopologyCache::Release(topo);
+        delete out;
+        throw;
+    }
+    TopologyCache::Release(topo);
+
+    return new eavlField(1, out, eavlField::ASSOC_POINTS);
+}
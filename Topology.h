@@ -0,0 +1,126 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include "STL.h"
+#include "eavlCellSet.h"
+#include "eavlDataSet.h"
+#include <QMutex>
+
+// ****************************************************************************
+// Struct:  CellSetTopology
+//
+// Purpose:
+///   Connectivity derived from a cell set.  Each part is built the first
+///   time someone asks for it (see TopologyCache), and never changes
+///   after that.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Added GetMemoryBytes.
+//
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   Added the reference count.
+//
+// ****************************************************************************
+struct CellSetTopology
+{
+    int                 ncells;
+
+    /// The callers still using this (see TopologyCache::Release), and
+    /// whether the cache has dropped it, to be freed when they're done.
+    /// Both are guarded by the cache's lock.
+    int                 refs;
+    bool                forgotten;
+
+    /// Node-to-cell incidence: the cells using point p, in increasing
+    /// order, are nodeCells[nodeCellStart[p]] to nodeCells[nodeCellStart[p+1]-1].
+    bool                haveNodeCells;
+    std::vector<int>    nodeCellStart;
+    std::vector<int>    nodeCells;
+
+    /// The unique faces (edges, for a 2D cell set), in order of the first
+    /// cell using them.  Face f has up to four points, faceNodes[4*f] on,
+    /// padded with -1 and wound as in its first cell, faceCells[2*f].
+    /// The other cell, faceCells[2*f+1], is -1 for an external face.
+    bool                haveFaces;
+    std::vector<int>    faceNodes;
+    std::vector<int>    faceCells;
+
+    /// The unique edges, two points each, in order of the first cell
+    /// using them.
+    bool                haveEdges;
+    std::vector<int>    edgeNodes;
+
+  public:
+    CellSetTopology(int n);
+    int GetNumFaces() const { return faceCells.size() / 2; }
+    int GetNumEdges() const { return edgeNodes.size() / 2; }
+    size_t GetMemoryBytes() const;
+};
+
+// ****************************************************************************
+// Class:  TopologyCache
+//
+// Purpose:
+///   Keeps the derived topology of each cell set, so the operations which
+///   need adjacency (external faces, recentering, ...) share it instead
+///   of each deriving their own.  A cell set is never changed once it's
+///   in a pipeline result (see CreateCopyOnWriteInput); an operation
+///   which changes connectivity gets a new cell set, and so a new entry.
+///   When the ResultCache frees a cell set, it tells us to forget it.
+///
+///   The face and edge tables are built with a parallel hash match:
+///   threads take blocks of cells and sort their faces into partitions
+///   by a hash of the face's points, then take partitions and sort each
+///   one to pair up the twins.  The incidence is built the same way,
+///   with the points partitioned by index.  No locks are needed.
+///
+///   This may be called from any thread.  Two threads asking for the
+///   same new part at once may both build it; one is thrown away.  The
+///   tables count against the ResultCache memory budget.
+///
+///   Each Get counts a reference to the topology it returns, which the
+///   caller gives back with Release.  Forget and ForgetAll drop it from
+///   the cache right away, but a topology still in use (e.g. by a
+///   proxy being built in the background) is only freed at its last
+///   Release.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:48:36 EDT 2026
+//   Count the tables in the ResultCache budget.
+//
+//   Jeremy Meredith, Mon Oct 19 01:58:42 EDT 2026
+//   Count references, so a topology isn't freed while it's being read.
+//   Added ForgetAll.
+//
+// ****************************************************************************
+class TopologyCache
+{
+  protected:
+    static QMutex                                  lock;
+    static std::map<eavlCellSet*,CellSetTopology*> topologies;
+
+  public:
+    static const CellSetTopology *GetNodeCells(eavlCellSet *cs, int npoints);
+    static const CellSetTopology *GetFaces(eavlCellSet *cs);
+    static const CellSetTopology *GetEdges(eavlCellSet *cs);
+    static void                   Release(const CellSetTopology *topo);
+    static void                   Forget(void *part);
+    static void                   ForgetAll();
+
+  protected:
+    static CellSetTopology *GetEntry(eavlCellSet *cs);
+    static void             Drop(CellSetTopology *topo);
+};
+
+eavlField *CreateNodeCenteredField(eavlDataSet *ds, eavlCellSet *cs,
+                                   eavlField *cellfield);
+
+#endif
@@ -10,6 +10,7 @@ class TransformAttributes : public Attribute
 {
   public:
     bool  transformCoordinates;
+    bool  renderOnly;
     int   csIndex;
     float rx, ry, rz;
     float sx, sy, sz;
@@ -19,6 +20,7 @@ class TransformAttributes : public Attribute
     TransformAttributes() : Attribute()
     {
         transformCoordinates = false;
+        renderOnly = false;
         csIndex = 0;
         rx = ry = rz = 0.;
         sx = sy = sz = 1.;
@@ -30,6 +32,7 @@ class TransformAttributes : public Attribute
     virtual void AddFields()
     {
         Add("Transform Coordinate Data", transformCoordinates);
+        Add("Apply at render time only", renderOnly);
         Add("Coordinate System Index", csIndex);
 
         Add("rx", rx);
@@ -50,23 +53,39 @@ class TransformAttributes : public Attribute
 //
 // Purpose:
 ///   Operation that sets a matrix transform within the coordinate system.
-///   Note: this currently has no settings.
+///
+///   When several transforms in a row rewrite the same coordinate data,
+///   the pipeline folds them (see Pipeline::FoldsIntoNext): all but the
+///   last just set their matrix on the coordinate system, and the last
+///   rewrites the coordinates once with the composed matrix.
+///
+///   At render time only, the operation changes nothing, and the 3D
+///   window moves its camera by the inverse of the matrix instead (see
+///   Pipeline::GetRenderTransform).  The camera can only express a
+///   rotation, a translation, and a uniform scale.  The pipeline leaves
+///   such a transform out of its stage keys, so changing it only redraws.
 //
 // Programmer:  Brad Whitlock
 // Creation:    September 19, 2012
 //
 // Modifications:
+//   Jeremy Meredith, Sun Oct 18 23:41:27 EDT 2026
+//   Split out GetMatrix and ExecuteWithMatrix so the pipeline can fold
+//   consecutive transforms.  Added the render-time-only mode.
+//
+//   Jeremy Meredith, Mon Oct 19 02:04:15 EDT 2026
+//   The pipeline checks the scale of a render-time transform, since
+//   changing only its settings doesn't execute anything.
+//
 // ****************************************************************************
 class TransformOperation : public Operation
 {
     TransformAttributes  *atts;
-    eavlTransformMutator *mutator;
   public:
     TransformOperation()
         : Operation()
     {
         atts = new TransformAttributes;
-        mutator = new eavlTransformMutator;
     }
     virtual std::string GetOperationName()
     {
@@ -161,21 +180,62 @@ class TransformOperation : public Operation
                 os << atts->tx<<","<<atts->ty<<","<<atts->tz;
             os << ")";
         }
+        if (atts->renderOnly)
+            os << " at render";
         return os.str();        
     }
     virtual Attribute *GetSettings()
     {
         return atts;
     }
-
-    virtual void Execute()
+    virtual DataSetParts GetModifiedParts(eavlDataSet *ds)
     {
-        mutator->SetDataSet(input);
- 
-        mutator->SetCoordinateSystemIndex(atts->csIndex);
-        mutator->SetTransformCoordinates(atts->transformCoordinates);
+        // the transform is set on the existing coordinate system, and
+        // if we're transforming the data, we rewrite its fields too
+        DataSetParts parts;
+        if (atts->renderOnly)
+            return parts;
+        parts.coordinateSystems.push_back(atts->csIndex);
+        if (atts->transformCoordinates &&
+            atts->csIndex < ds->GetNumCoordinateSystems())
+        {
+            eavlCoordinates *cs = ds->GetCoordinateSystem(atts->csIndex);
+            for (int i=0; i<cs->GetDimension(); ++i)
+            {
+                eavlCoordinateAxisField *axis =
+                    dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(i));
+                if (axis)
+                    parts.fields.push_back(axis->GetFieldName());
+            }
+        }
+        return parts;
+    }
 
-        // Build up transform from different components. Do more here, add rotation, etc.
+    /// True if Execute rewrites the coordinate data.
+    bool RewritesCoordinates()
+    {
+        return atts->transformCoordinates && !atts->renderOnly;
+    }
+    /// True if the transform is left for the renderer.
+    bool AppliesAtRenderTime()
+    {
+        return atts->renderOnly;
+    }
+    /// True if the camera can apply our scale.
+    bool HasUniformScale()
+    {
+        return atts->sx == atts->sy && atts->sx == atts->sz;
+    }
+    int GetCoordinateSystemIndex()
+    {
+        return atts->csIndex;
+    }
+    /// Build up the transform from the different components.  This is
+    /// for row vectors (p' = p*M, so the translation is in row 3): the
+    /// rotations about x, y, and z apply first, then the scale, then
+    /// the translation.
+    eavlMatrix4x4 GetMatrix()
+    {
         eavlMatrix4x4 M;
         M(0,0) = atts->sx;
         M(1,1) = atts->sy;
@@ -189,11 +249,29 @@ class TransformOperation : public Operation
         ry.CreateRotateY(atts->ry * (3.141592653589793 / 180.));
         rz.CreateRotateZ(atts->rz * (3.141592653589793 / 180.));
 
-        M = rx * ry * rz * M;
-        mutator->SetTransform(M);
+        return rx * ry * rz * M;
+    }
+    /// Apply a matrix (ours, or several composed) to our coordinate
+    /// system, rewriting the coordinate data or not.
+    eavlDataSet *ExecuteWithMatrix(eavlDataSet *input, const eavlMatrix4x4 &M,
+                                   bool rewrite)
+    {
+        eavlTransformMutator mutator;
+        mutator.SetDataSet(input);
+        mutator.SetCoordinateSystemIndex(atts->csIndex);
+        mutator.SetTransformCoordinates(rewrite);
+        mutator.SetTransform(M);
+        QMutexLocker lock(&eavlExecutorMutex);
+        mutator.Execute();
+        return input;
+    }
 
-        mutator->Execute();
-        output = input;
+    virtual eavlDataSet *Execute(eavlDataSet *input)
+    {
+        if (atts->renderOnly)
+            return input;
+        return ExecuteWithMatrix(input, GetMatrix(),
+                                 atts->transformCoordinates);
     }
 };
 
@@ -0,0 +1,604 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "Pipeline.h"
+#include "ResultCache.h"
+#include "StageStats.h"
+
+#include <eavlCUDA.h>
+#include <eavlException.h>
+#include <eavlCellSetAllStructured.h>
+#include <eavlCellSetExplicit.h>
+#include <eavlCoordinates.h>
+#include <eavlLogicalStructureRegular.h>
+
+#include <QThread>
+
+#include <cmath>
+#include <fstream>
+
+// ****************************************************************************
+// Operator micro-benchmarks.
+//
+//   Generates structured and unstructured meshes with analytic fields,
+//   times each operation on them, and then a whole pipeline through
+//   Pipeline::Execute, reporting the throughput as JSON, e.g.
+//     eavlab-benchmark -cells 1000000 -reps 3 -o results.json
+//
+//   The meshes cover [-1,1] in each dimension.  "scalar" is the squared
+//   distance from the origin, and "vector" is a swirl around z.
+//
+//   Every repetition starts cold: the indexes and other information
+//   the caches keep about the input mesh (e.g. span space, topology)
+//   are forgotten first, so building them is timed every time.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:40:17 EDT 2026
+//   Forget what the caches derived from the input between repetitions.
+//
+// ****************************************************************************
+
+struct BenchmarkResult
+{
+    string mesh;
+    string test;
+    long   inCells;
+    long   outCells;
+    size_t bytes;
+    int    reps;
+    double minTime;
+    double meanTime;
+};
+
+// ****************************************************************************
+// Function:  AddAnalyticFields
+//
+// Purpose:
+///   Add the nodal "scalar" and "vector" fields given the point positions.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+AddAnalyticFields(eavlDataSet *ds, const vector<float> &x,
+                  const vector<float> &y, const vector<float> &z)
+{
+    int npts = ds->GetNumPoints();
+    eavlFloatArray *scalar = new eavlFloatArray("scalar", 1, npts);
+    eavlFloatArray *vec = new eavlFloatArray("vector", 3, npts);
+    for (int i=0; i<npts; ++i)
+    {
+        scalar->SetValue(i, x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+        vec->SetComponentFromDouble(i, 0, -y[i]);
+        vec->SetComponentFromDouble(i, 1, x[i]);
+        vec->SetComponentFromDouble(i, 2, z[i]);
+    }
+    ds->AddField(new eavlField(1, scalar, eavlField::ASSOC_POINTS));
+    ds->AddField(new eavlField(1, vec, eavlField::ASSOC_POINTS));
+}
+
+// ****************************************************************************
+// Function:  CreateStructuredMesh
+//
+// Purpose:
+///   Create a rectilinear mesh with the given number of nodes in each
+///   dimension.  With nk==1, it's a 2D mesh.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static eavlDataSet *
+CreateStructuredMesh(int ni, int nj, int nk)
+{
+    int ndims = (nk > 1) ? 3 : 2;
+    int dims[3] = {ni, nj, nk};
+    const char *axisnames[3] = {"xcoord", "ycoord", "zcoord"};
+
+    eavlDataSet *ds = new eavlDataSet;
+    ds->SetNumPoints(ni*nj*nk);
+
+    eavlRegularStructure reg;
+    if (ndims == 3)
+        reg.SetNodeDimension3D(ni, nj, nk);
+    else
+        reg.SetNodeDimension2D(ni, nj);
+    eavlLogicalStructureRegular *log = new eavlLogicalStructureRegular(ndims, reg);
+    ds->SetLogicalStructure(log);
+
+    vector<float> axes[3];
+    for (int d=0; d<ndims; ++d)
+    {
+        eavlFloatArray *arr = new eavlFloatArray(axisnames[d], 1, dims[d]);
+        for (int i=0; i<dims[d]; ++i)
+        {
+            float v = -1. + 2. * float(i) / float(dims[d]-1);
+            arr->SetValue(i, v);
+            axes[d].push_back(v);
+        }
+        ds->AddField(new eavlField(1, arr, eavlField::ASSOC_LOGICALDIM, d));
+    }
+
+    eavlCoordinatesCartesian *coords;
+    if (ndims == 3)
+        coords = new eavlCoordinatesCartesian(log,
+                                              eavlCoordinatesCartesian::X,
+                                              eavlCoordinatesCartesian::Y,
+                                              eavlCoordinatesCartesian::Z);
+    else
+        coords = new eavlCoordinatesCartesian(log,
+                                              eavlCoordinatesCartesian::X,
+                                              eavlCoordinatesCartesian::Y);
+    for (int d=0; d<ndims; ++d)
+        coords->SetAxis(d, new eavlCoordinateAxisField(axisnames[d]));
+    ds->AddCoordinateSystem(coords);
+
+    ds->AddCellSet(new eavlCellSetAllStructured("cells", reg));
+
+    // the analytic fields need every point's position
+    long npts = long(ni)*nj*nk;
+    vector<float> x(npts), y(npts), z(npts, 0.f);
+    for (long p=0; p<npts; ++p)
+    {
+        x[p] = axes[0][p % ni];
+        y[p] = axes[1][(p / ni) % nj];
+        if (ndims == 3)
+            z[p] = axes[2][p / (long(ni)*nj)];
+    }
+    AddAnalyticFields(ds, x, y, z);
+    return ds;
+}
+
+// ****************************************************************************
+// Function:  CreateUnstructuredMesh
+//
+// Purpose:
+///   Create a mesh of explicit hexahedra with explicit point coordinates,
+///   covering the same space as a structured mesh with these dimensions.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static eavlDataSet *
+CreateUnstructuredMesh(int ni, int nj, int nk)
+{
+    long npts = long(ni)*nj*nk;
+    eavlDataSet *ds = new eavlDataSet;
+    ds->SetNumPoints(npts);
+
+    eavlFloatArray *pts = new eavlFloatArray("coords", 3, npts);
+    vector<float> x(npts), y(npts), z(npts);
+    for (long p=0; p<npts; ++p)
+    {
+        x[p] = -1. + 2. * float(p % ni) / float(ni-1);
+        y[p] = -1. + 2. * float((p / ni) % nj) / float(nj-1);
+        z[p] = -1. + 2. * float(p / (long(ni)*nj)) / float(nk-1);
+        pts->SetComponentFromDouble(p, 0, x[p]);
+        pts->SetComponentFromDouble(p, 1, y[p]);
+        pts->SetComponentFromDouble(p, 2, z[p]);
+    }
+    ds->AddField(new eavlField(1, pts, eavlField::ASSOC_POINTS));
+
+    eavlCoordinatesCartesian *coords =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    for (int d=0; d<3; ++d)
+        coords->SetAxis(d, new eavlCoordinateAxisField("coords", d));
+    ds->AddCoordinateSystem(coords);
+
+    eavlExplicitConnectivity conn;
+    for (int k=0; k<nk-1; ++k)
+    {
+        for (int j=0; j<nj-1; ++j)
+        {
+            for (int i=0; i<ni-1; ++i)
+            {
+                int p = (k*nj + j)*ni + i;
+                int ids[8] = { p,          p+1,          p+ni+1,          p+ni,
+                               p+ni*nj,    p+ni*nj+1,    p+ni*nj+ni+1,    p+ni*nj+ni };
+                conn.AddElement(EAVL_HEX, 8, ids);
+            }
+        }
+    }
+    eavlCellSetExplicit *cells = new eavlCellSetExplicit("cells", 3);
+    cells->SetCellNodeConnectivity(conn);
+    ds->AddCellSet(cells);
+
+    AddAnalyticFields(ds, x, y, z);
+    return ds;
+}
+
+// ****************************************************************************
+// Functions:  FindSetting, SetSetting
+//
+// Purpose:
+///   Find and set a field of an operation's settings by name.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static int
+FindSetting(Operation *op, const string &name)
+{
+    Attribute *atts = op->GetSettings();
+    for (int i=0; i<atts->GetNumFields(); ++i)
+    {
+        if (atts->GetFieldName(i) == name)
+            return i;
+    }
+    throw eavlException(op->GetOperationName() + " has no setting " + name);
+}
+
+static void
+SetSetting(Operation *op, const string &name, const string &value)
+{
+    op->GetSettings()->SetFieldFromString(value, FindSetting(op, name));
+}
+
+static void
+SetSetting(Operation *op, const string &name, double value)
+{
+    op->GetSettings()->SetFieldFromDouble(value, FindSetting(op, name));
+}
+
+// ****************************************************************************
+// Function:  CreateBenchmarkOperation
+//
+// Purpose:
+///   Create an operation with settings which do a representative
+///   amount of work on the analytic fields.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static Operation *
+CreateBenchmarkOperation(const string &name)
+{
+    Operation *op = Pipeline::CreateOperation(name);
+    if (!op)
+        throw eavlException("unknown operation " + name);
+
+    if (name == "Isosurface")
+    {
+        SetSetting(op, "field", "scalar");
+        SetSetting(op, "value", 1.0);
+    }
+    else if (name == "Threshold")
+    {
+        SetSetting(op, "Field name", "scalar");
+        SetSetting(op, "Minimum value", 0.5);
+        SetSetting(op, "Maximum value", 1.5);
+    }
+    else if (name == "Histogram")
+    {
+        SetSetting(op, "field", "scalar");
+        SetSetting(op, "nbins", 256);
+    }
+    else if (name == "Elevate")
+    {
+        SetSetting(op, "field", "scalar");
+    }
+    else if (name == "Transform")
+    {
+        SetSetting(op, "Transform Coordinate Data", 1);
+        SetSetting(op, "rz", 30);
+        SetSetting(op, "sx", 2);
+    }
+    return op;
+}
+
+// ****************************************************************************
+// Function:  FreeResults
+//
+// Purpose:
+///   Free everything added to the ResultCache except the input meshes,
+///   which were added as external so they stay.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+FreeResults()
+{
+    size_t budget = ResultCache::GetMemoryBudget();
+    ResultCache::SetMemoryBudget(0);
+    ResultCache::Trim(std::set<eavlDataSet*>());
+    ResultCache::SetMemoryBudget(budget);
+}
+
+// ****************************************************************************
+// Function:  ForgetDerived
+//
+// Purpose:
+///   Make the caches forget the indexes and such they've built for an
+///   input mesh, so the next repetition has to build them again.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+ForgetDerived(eavlDataSet *mesh)
+{
+    for (int i=0; i<mesh->GetNumFields(); ++i)
+        ResultCache::ForgetDerived(mesh->GetField(i)->GetArray());
+    for (int i=0; i<mesh->GetNumCellSets(); ++i)
+        ResultCache::ForgetDerived(mesh->GetCellSet(i));
+}
+
+// ****************************************************************************
+// Function:  BenchmarkOperation
+//
+// Purpose:
+///   Time one operation on one mesh, the way the pipeline executes it
+///   (on a copy-on-write input), but not counting making the input.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:40:17 EDT 2026
+//   Start each repetition cold.  Free the input if it isn't the output.
+//
+// ****************************************************************************
+static BenchmarkResult
+BenchmarkOperation(const string &meshname, eavlDataSet *mesh,
+                   const string &opname, int reps)
+{
+    Operation *op = CreateBenchmarkOperation(opname);
+
+    BenchmarkResult r;
+    r.mesh = meshname;
+    r.test = opname;
+    r.inCells = StageStats::GetNumCells(mesh);
+    r.outCells = 0;
+    r.bytes = ResultCache::GetDataSetBytes(mesh);
+    r.reps = reps;
+    r.minTime = 0;
+    r.meanTime = 0;
+    for (int i=0; i<reps; ++i)
+    {
+        ForgetDerived(mesh);
+        eavlDataSet *in = CreateCopyOnWriteInput(mesh, op->GetModifiedParts(mesh));
+        double t0 = StageTimer::GetWallTime();
+        eavlDataSet *out = op->Execute(in);
+        double t = StageTimer::GetWallTime() - t0;
+        FreeCopyOnWriteInput(mesh, in, out);
+
+        r.outCells = StageStats::GetNumCells(out);
+        r.meanTime += t / reps;
+        if (i == 0 || t < r.minTime)
+            r.minTime = t;
+
+        ResultCache::Add("Benchmark:" + meshname + ":" + opname, i, out, false);
+        FreeResults();
+    }
+    cerr << meshname << " " << opname << ": " << r.minTime << "s" << endl;
+    return r;
+}
+
+// ****************************************************************************
+// Function:  BenchmarkPipeline
+//
+// Purpose:
+///   Time Pipeline::Execute end-to-end for a threshold, external face,
+///   surface normals, transform pipeline, with the mesh as every chunk.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+//   Jeremy Meredith, Mon Oct 19 01:40:17 EDT 2026
+//   Start each repetition cold.
+//
+// ****************************************************************************
+static BenchmarkResult
+BenchmarkPipeline(const string &meshname, eavlDataSet *mesh,
+                  int nchunks, int reps)
+{
+    Pipeline *pipe = new Pipeline;
+    pipe->source->file = "Benchmark:" + meshname;
+    pipe->source->mesh = "mesh";
+    pipe->ops.push_back(CreateBenchmarkOperation("Threshold"));
+    pipe->ops.push_back(CreateBenchmarkOperation("ExternalFace"));
+    pipe->ops.push_back(CreateBenchmarkOperation("SurfaceNormals"));
+    pipe->ops.push_back(CreateBenchmarkOperation("Transform"));
+
+    BenchmarkResult r;
+    r.mesh = meshname;
+    r.test = "Pipeline";
+    r.inCells = StageStats::GetNumCells(mesh) * nchunks;
+    r.outCells = 0;
+    r.bytes = ResultCache::GetDataSetBytes(mesh) * nchunks;
+    r.reps = reps;
+    r.minTime = 0;
+    r.meanTime = 0;
+    for (int i=0; i<reps; ++i)
+    {
+        // there's no source to read from; start from the mesh itself
+        ForgetDerived(mesh);
+        pipe->ClearResults();
+        pipe->results.push_back(std::vector<eavlDataSet*>(nchunks, mesh));
+        pipe->Execute();
+
+        double t = pipe->executeTime;
+        r.outCells = pipe->GetStageStats(pipe->ops.size()).outCells;
+        r.meanTime += t / reps;
+        if (i == 0 || t < r.minTime)
+            r.minTime = t;
+
+        pipe->ClearResults();
+        FreeResults();
+    }
+    cerr << meshname << " Pipeline: " << r.minTime << "s" << endl;
+    return r;
+}
+
+// ****************************************************************************
+// Function:  WriteJSON
+//
+// Purpose:
+///   Write the results.  Throughput is for the fastest repetition.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+WriteJSON(ostream &out, long ncells, const vector<BenchmarkResult> &results)
+{
+    out << "{" << endl;
+    out << "  \"cells\": " << ncells << "," << endl;
+    out << "  \"threads\": " << QThread::idealThreadCount() << "," << endl;
+    out << "  \"results\": [" << endl;
+    for (size_t i=0; i<results.size(); ++i)
+    {
+        const BenchmarkResult &r = results[i];
+        double t = (r.minTime > 0) ? r.minTime : 1e-9;
+        out << "    {"
+            << "\"mesh\": \"" << r.mesh << "\", "
+            << "\"test\": \"" << r.test << "\", "
+            << "\"in_cells\": " << r.inCells << ", "
+            << "\"out_cells\": " << r.outCells << ", "
+            << "\"bytes\": " << r.bytes << ", "
+            << "\"reps\": " << r.reps << ", "
+            << "\"min_seconds\": " << r.minTime << ", "
+            << "\"mean_seconds\": " << r.meanTime << ", "
+            << "\"cells_per_second\": " << double(r.inCells) / t << ", "
+            << "\"bytes_per_second\": " << double(r.bytes) / t
+            << "}" << (i+1 < results.size() ? "," : "") << endl;
+    }
+    out << "  ]" << endl;
+    out << "}" << endl;
+}
+
+static void
+Usage(const char *prog)
+{
+    cerr << "Usage: " << prog << " [options]\n"
+         << "  -cells <n>       approximate cells per mesh (default 1000000)\n"
+         << "  -mesh <type>     structured, unstructured, or both (default)\n"
+         << "  -reps <n>        repetitions of each test (default 3)\n"
+         << "  -chunks <n>      chunks for the pipeline test (default 4)\n"
+         << "  -o <file>        write the JSON here instead of stdout\n";
+}
+
+int main(int argc, char *argv[])
+{
+    long ncells = 1000000;
+    string meshtype = "both";
+    int reps = 3;
+    int nchunks = 4;
+    string outfile;
+    for (int i=1; i<argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-cells" && i+1 < argc)
+            ncells = atol(argv[++i]);
+        else if (arg == "-mesh" && i+1 < argc)
+            meshtype = argv[++i];
+        else if (arg == "-reps" && i+1 < argc)
+            reps = atoi(argv[++i]);
+        else if (arg == "-chunks" && i+1 < argc)
+            nchunks = atoi(argv[++i]);
+        else if (arg == "-o" && i+1 < argc)
+            outfile = argv[++i];
+        else
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+    }
+    if (ncells < 1 || reps < 1 || nchunks < 1 ||
+        (meshtype != "structured" && meshtype != "unstructured" &&
+         meshtype != "both"))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        eavlInitializeGPU();
+
+        // n^3 cells in 3D, and about the same number in 2D for Elevate
+        int n3 = std::max(1, int(floor(cbrt(double(ncells)) + 0.5)));
+        int n2 = std::max(1, int(floor(sqrt(double(ncells)) + 0.5)));
+
+        const char *ops3d[] = {
+            "Isosurface", "Threshold", "ExternalFace", "Histogram",
+            "Transform", NULL
+        };
+
+        vector<BenchmarkResult> results;
+        for (int m=0; m<2; ++m)
+        {
+            string meshname = (m == 0) ? "structured" : "unstructured";
+            if (meshtype != "both" && meshtype != meshname)
+                continue;
+
+            cerr << "Creating " << meshname << " meshes" << endl;
+            eavlDataSet *mesh = (m == 0) ?
+                CreateStructuredMesh(n3+1, n3+1, n3+1) :
+                CreateUnstructuredMesh(n3+1, n3+1, n3+1);
+            ResultCache::Add("Benchmark:" + meshname, 0, mesh, true);
+
+            for (int i=0; ops3d[i] != NULL; ++i)
+                results.push_back(BenchmarkOperation(meshname, mesh,
+                                                     ops3d[i], reps));
+
+            // surface normals need a surface
+            Operation *faces = CreateBenchmarkOperation("ExternalFace");
+            eavlDataSet *surface = faces->Execute(
+                CreateCopyOnWriteInput(mesh, faces->GetModifiedParts(mesh)));
+            ResultCache::Add("Benchmark:" + meshname + ":surface", 0,
+                             surface, true);
+            results.push_back(BenchmarkOperation(meshname + "-surface", surface,
+                                                 "SurfaceNormals", reps));
+
+            // elevate needs a 2D mesh; we only make a structured one
+            if (m == 0)
+            {
+                eavlDataSet *mesh2d = CreateStructuredMesh(n2+1, n2+1, 1);
+                ResultCache::Add("Benchmark:" + meshname + "2d", 0,
+                                 mesh2d, true);
+                results.push_back(BenchmarkOperation(meshname + "-2d", mesh2d,
+                                                     "Elevate", reps));
+            }
+
+            results.push_back(BenchmarkPipeline(meshname, mesh, nchunks, reps));
+        }
+
+        if (outfile != "")
+        {
+            ofstream out(outfile.c_str());
+            WriteJSON(out, ncells, results);
+        }
+        else
+        {
+            WriteJSON(cout, ncells, results);
+        }
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        return 1;
+    }
+    return 0;
+}
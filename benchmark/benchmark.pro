@@ -0,0 +1,30 @@
+# Operator micro-benchmarks; see Benchmark.cpp.  Builds the pipeline
+# engine from the parent directory without any of the GUI.
+
+CONFIG += release console
+CONFIG -= app_bundle
+
+QT       += core gui
+
+TARGET = eavlab-benchmark
+TEMPLATE = app
+
+SOURCES += Benchmark.cpp \
+    ../Attribute.cpp \
+    ../CopyOnWrite.cpp \
+    ../ExternalFaces.cpp \
+    ../FieldStats.cpp \
+    ../Geometry.cpp \
+    ../Histogram.cpp \
+    ../Pipeline.cpp \
+    ../ResultCache.cpp \
+    ../SortedIndex.cpp \
+    ../SpanSpace.cpp \
+    ../Topology.cpp \
+    ../StageStats.cpp \
+    ../XMLTools.cpp
+
+INCLUDEPATH += ..
+DEPENDPATH += ..
+
+include(../eavl.pri)
@@ -1,6 +1,8 @@
 // Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
 #include <QtGui/QApplication>
 #include "ELMainWindow.h"
+#include "ResultCache.h"
+#include "Batch.h"
 
 #include <eavlDataSet.h>
 #include <eavlException.h>
@@ -12,6 +14,15 @@ int main(int argc, char *argv[])
     {
         eavlInitializeGPU();
 
+        // memory for cached pipeline results, in MB
+        const char *budget = getenv("EAVLAB_MEMORY_BUDGET");
+        if (budget && atoi(budget) > 0)
+            ResultCache::SetMemoryBudget(size_t(atoi(budget)) << 20);
+
+        // no GUI at all in batch mode
+        if (argc >= 2 && string(argv[1]) == "-batch")
+            return RunBatch(argc, argv);
+
         QApplication a(argc, argv);
 
         ELMainWindow w;